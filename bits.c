@@ -18,7 +18,7 @@
 
 #include "bits.h"
 
-uint64_t ubits(unsigned char buf[], unsigned int start, unsigned int width, bool le)
+uint64_t ubits(const unsigned char buf[], unsigned int start, unsigned int width, bool le)
 /* extract a (zero-origin) bitfield from the buffer as an unsigned big-endian uint64_t */
 {
     uint64_t fld = 0;
@@ -57,10 +57,10 @@ uint64_t ubits(unsigned char buf[], unsigned int start, unsigned int width, bool
     return fld;
 }
 
-int64_t sbits(signed char buf[], unsigned int start, unsigned int width, bool le)
+int64_t sbits(const signed char buf[], unsigned int start, unsigned int width, bool le)
 /* extract a bitfield from the buffer as a signed big-endian long */
 {
-    uint64_t fld = ubits((unsigned char *)buf, start, width, le);
+    uint64_t fld = ubits((const unsigned char *)buf, start, width, le);
 
     /* ensure width > 0 as the result of
        1ULL << (width - 1)
@@ -58,7 +58,7 @@ extern void putbed64(char *, int, double);
 extern void shiftleft(unsigned char *, int, unsigned short);
 
 /* bitfield extraction */
-extern uint64_t ubits(unsigned char buf[], unsigned int, unsigned int, bool);
-extern int64_t sbits(signed char buf[], unsigned int, unsigned int, bool);
+extern uint64_t ubits(const unsigned char buf[], unsigned int, unsigned int, bool);
+extern int64_t sbits(const signed char buf[], unsigned int, unsigned int, bool);
 
 #endif /* _GPSD_BITS_H_ */
@@ -27,6 +27,7 @@
  * SPDX-License-Identifier: BSD-2-clause
  */
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -60,7 +61,8 @@ static void crc_init(unsigned int table[256])
 
 int main(int argc, char *argv[])
 {
-    int i;
+    unsigned table[256], slice[8][256];
+    int i, k;
 
     crc_init(table);
 
@@ -70,6 +72,23 @@ int main(int argc, char *argv[])
 	    putchar('\n');
     }
 
+    /* the slicing-by-8 tables */
+    for (i = 0; i < 256; i++)
+	slice[0][i] = (table[i] & 0x00ffffffu) << 8;
+    for (k = 1; k < 8; k++)
+	for (i = 0; i < 256; i++)
+	    slice[k][i] = (slice[k - 1][i] << 8)
+		^ slice[0][slice[k - 1][i] >> 24];
+    for (k = 0; k < 8; k++) {
+	(void)puts("{");
+	for (i = 0; i < 256; i++) {
+	    printf("0x%08Xu, ", slice[k][i]);
+	    if ((i % 4) == 3)
+		putchar('\n');
+	}
+	(void)puts("},");
+    }
+
     exit(EXIT_SUCCESS);
 }
 #endif
@@ -141,18 +160,584 @@ static const int unsigned crc24q[256] = {
     0xFCD11CCEu, 0xFD575035u, 0xFE5BC9C3u, 0xFFDD8538u,
 };
 
-unsigned crc24q_hash(unsigned char *data, int len)
+/*
+ * Slicing-by-8.  The CRC is kept in the top 24 bits of a 32-bit word,
+ * which turns it into an ordinary MSB-first CRC-32 with polynomial
+ * 0x864CFB00, and eight bytes are then folded in with eight table
+ * lookups per step instead of one per byte.  slice[k][b] is the CRC
+ * of byte b followed by k zero bytes; slice[0] is crc24q[] shifted
+ * up.  The REBUILD_CRC_TABLE code above regenerates these too.
+ */
+static const uint32_t slice[8][256] = {
+    {
+	0x00000000u, 0x864CFB00u, 0x8AD50D00u, 0x0C99F600u,
+	0x93E6E100u, 0x15AA1A00u, 0x1933EC00u, 0x9F7F1700u,
+	0xA1813900u, 0x27CDC200u, 0x2B543400u, 0xAD18CF00u,
+	0x3267D800u, 0xB42B2300u, 0xB8B2D500u, 0x3EFE2E00u,
+	0xC54E8900u, 0x43027200u, 0x4F9B8400u, 0xC9D77F00u,
+	0x56A86800u, 0xD0E49300u, 0xDC7D6500u, 0x5A319E00u,
+	0x64CFB000u, 0xE2834B00u, 0xEE1ABD00u, 0x68564600u,
+	0xF7295100u, 0x7165AA00u, 0x7DFC5C00u, 0xFBB0A700u,
+	0x0CD1E900u, 0x8A9D1200u, 0x8604E400u, 0x00481F00u,
+	0x9F370800u, 0x197BF300u, 0x15E20500u, 0x93AEFE00u,
+	0xAD50D000u, 0x2B1C2B00u, 0x2785DD00u, 0xA1C92600u,
+	0x3EB63100u, 0xB8FACA00u, 0xB4633C00u, 0x322FC700u,
+	0xC99F6000u, 0x4FD39B00u, 0x434A6D00u, 0xC5069600u,
+	0x5A798100u, 0xDC357A00u, 0xD0AC8C00u, 0x56E07700u,
+	0x681E5900u, 0xEE52A200u, 0xE2CB5400u, 0x6487AF00u,
+	0xFBF8B800u, 0x7DB44300u, 0x712DB500u, 0xF7614E00u,
+	0x19A3D200u, 0x9FEF2900u, 0x9376DF00u, 0x153A2400u,
+	0x8A453300u, 0x0C09C800u, 0x00903E00u, 0x86DCC500u,
+	0xB822EB00u, 0x3E6E1000u, 0x32F7E600u, 0xB4BB1D00u,
+	0x2BC40A00u, 0xAD88F100u, 0xA1110700u, 0x275DFC00u,
+	0xDCED5B00u, 0x5AA1A000u, 0x56385600u, 0xD074AD00u,
+	0x4F0BBA00u, 0xC9474100u, 0xC5DEB700u, 0x43924C00u,
+	0x7D6C6200u, 0xFB209900u, 0xF7B96F00u, 0x71F59400u,
+	0xEE8A8300u, 0x68C67800u, 0x645F8E00u, 0xE2137500u,
+	0x15723B00u, 0x933EC000u, 0x9FA73600u, 0x19EBCD00u,
+	0x8694DA00u, 0x00D82100u, 0x0C41D700u, 0x8A0D2C00u,
+	0xB4F30200u, 0x32BFF900u, 0x3E260F00u, 0xB86AF400u,
+	0x2715E300u, 0xA1591800u, 0xADC0EE00u, 0x2B8C1500u,
+	0xD03CB200u, 0x56704900u, 0x5AE9BF00u, 0xDCA54400u,
+	0x43DA5300u, 0xC596A800u, 0xC90F5E00u, 0x4F43A500u,
+	0x71BD8B00u, 0xF7F17000u, 0xFB688600u, 0x7D247D00u,
+	0xE25B6A00u, 0x64179100u, 0x688E6700u, 0xEEC29C00u,
+	0x3347A400u, 0xB50B5F00u, 0xB992A900u, 0x3FDE5200u,
+	0xA0A14500u, 0x26EDBE00u, 0x2A744800u, 0xAC38B300u,
+	0x92C69D00u, 0x148A6600u, 0x18139000u, 0x9E5F6B00u,
+	0x01207C00u, 0x876C8700u, 0x8BF57100u, 0x0DB98A00u,
+	0xF6092D00u, 0x7045D600u, 0x7CDC2000u, 0xFA90DB00u,
+	0x65EFCC00u, 0xE3A33700u, 0xEF3AC100u, 0x69763A00u,
+	0x57881400u, 0xD1C4EF00u, 0xDD5D1900u, 0x5B11E200u,
+	0xC46EF500u, 0x42220E00u, 0x4EBBF800u, 0xC8F70300u,
+	0x3F964D00u, 0xB9DAB600u, 0xB5434000u, 0x330FBB00u,
+	0xAC70AC00u, 0x2A3C5700u, 0x26A5A100u, 0xA0E95A00u,
+	0x9E177400u, 0x185B8F00u, 0x14C27900u, 0x928E8200u,
+	0x0DF19500u, 0x8BBD6E00u, 0x87249800u, 0x01686300u,
+	0xFAD8C400u, 0x7C943F00u, 0x700DC900u, 0xF6413200u,
+	0x693E2500u, 0xEF72DE00u, 0xE3EB2800u, 0x65A7D300u,
+	0x5B59FD00u, 0xDD150600u, 0xD18CF000u, 0x57C00B00u,
+	0xC8BF1C00u, 0x4EF3E700u, 0x426A1100u, 0xC426EA00u,
+	0x2AE47600u, 0xACA88D00u, 0xA0317B00u, 0x267D8000u,
+	0xB9029700u, 0x3F4E6C00u, 0x33D79A00u, 0xB59B6100u,
+	0x8B654F00u, 0x0D29B400u, 0x01B04200u, 0x87FCB900u,
+	0x1883AE00u, 0x9ECF5500u, 0x9256A300u, 0x141A5800u,
+	0xEFAAFF00u, 0x69E60400u, 0x657FF200u, 0xE3330900u,
+	0x7C4C1E00u, 0xFA00E500u, 0xF6991300u, 0x70D5E800u,
+	0x4E2BC600u, 0xC8673D00u, 0xC4FECB00u, 0x42B23000u,
+	0xDDCD2700u, 0x5B81DC00u, 0x57182A00u, 0xD154D100u,
+	0x26359F00u, 0xA0796400u, 0xACE09200u, 0x2AAC6900u,
+	0xB5D37E00u, 0x339F8500u, 0x3F067300u, 0xB94A8800u,
+	0x87B4A600u, 0x01F85D00u, 0x0D61AB00u, 0x8B2D5000u,
+	0x14524700u, 0x921EBC00u, 0x9E874A00u, 0x18CBB100u,
+	0xE37B1600u, 0x6537ED00u, 0x69AE1B00u, 0xEFE2E000u,
+	0x709DF700u, 0xF6D10C00u, 0xFA48FA00u, 0x7C040100u,
+	0x42FA2F00u, 0xC4B6D400u, 0xC82F2200u, 0x4E63D900u,
+	0xD11CCE00u, 0x57503500u, 0x5BC9C300u, 0xDD853800u,
+    },
+    {
+	0x00000000u, 0x668F4800u, 0xCD1E9000u, 0xAB91D800u,
+	0x1C71DB00u, 0x7AFE9300u, 0xD16F4B00u, 0xB7E00300u,
+	0x38E3B600u, 0x5E6CFE00u, 0xF5FD2600u, 0x93726E00u,
+	0x24926D00u, 0x421D2500u, 0xE98CFD00u, 0x8F03B500u,
+	0x71C76C00u, 0x17482400u, 0xBCD9FC00u, 0xDA56B400u,
+	0x6DB6B700u, 0x0B39FF00u, 0xA0A82700u, 0xC6276F00u,
+	0x4924DA00u, 0x2FAB9200u, 0x843A4A00u, 0xE2B50200u,
+	0x55550100u, 0x33DA4900u, 0x984B9100u, 0xFEC4D900u,
+	0xE38ED800u, 0x85019000u, 0x2E904800u, 0x481F0000u,
+	0xFFFF0300u, 0x99704B00u, 0x32E19300u, 0x546EDB00u,
+	0xDB6D6E00u, 0xBDE22600u, 0x1673FE00u, 0x70FCB600u,
+	0xC71CB500u, 0xA193FD00u, 0x0A022500u, 0x6C8D6D00u,
+	0x9249B400u, 0xF4C6FC00u, 0x5F572400u, 0x39D86C00u,
+	0x8E386F00u, 0xE8B72700u, 0x4326FF00u, 0x25A9B700u,
+	0xAAAA0200u, 0xCC254A00u, 0x67B49200u, 0x013BDA00u,
+	0xB6DBD900u, 0xD0549100u, 0x7BC54900u, 0x1D4A0100u,
+	0x41514B00u, 0x27DE0300u, 0x8C4FDB00u, 0xEAC09300u,
+	0x5D209000u, 0x3BAFD800u, 0x903E0000u, 0xF6B14800u,
+	0x79B2FD00u, 0x1F3DB500u, 0xB4AC6D00u, 0xD2232500u,
+	0x65C32600u, 0x034C6E00u, 0xA8DDB600u, 0xCE52FE00u,
+	0x30962700u, 0x56196F00u, 0xFD88B700u, 0x9B07FF00u,
+	0x2CE7FC00u, 0x4A68B400u, 0xE1F96C00u, 0x87762400u,
+	0x08759100u, 0x6EFAD900u, 0xC56B0100u, 0xA3E44900u,
+	0x14044A00u, 0x728B0200u, 0xD91ADA00u, 0xBF959200u,
+	0xA2DF9300u, 0xC450DB00u, 0x6FC10300u, 0x094E4B00u,
+	0xBEAE4800u, 0xD8210000u, 0x73B0D800u, 0x153F9000u,
+	0x9A3C2500u, 0xFCB36D00u, 0x5722B500u, 0x31ADFD00u,
+	0x864DFE00u, 0xE0C2B600u, 0x4B536E00u, 0x2DDC2600u,
+	0xD318FF00u, 0xB597B700u, 0x1E066F00u, 0x78892700u,
+	0xCF692400u, 0xA9E66C00u, 0x0277B400u, 0x64F8FC00u,
+	0xEBFB4900u, 0x8D740100u, 0x26E5D900u, 0x406A9100u,
+	0xF78A9200u, 0x9105DA00u, 0x3A940200u, 0x5C1B4A00u,
+	0x82A29600u, 0xE42DDE00u, 0x4FBC0600u, 0x29334E00u,
+	0x9ED34D00u, 0xF85C0500u, 0x53CDDD00u, 0x35429500u,
+	0xBA412000u, 0xDCCE6800u, 0x775FB000u, 0x11D0F800u,
+	0xA630FB00u, 0xC0BFB300u, 0x6B2E6B00u, 0x0DA12300u,
+	0xF365FA00u, 0x95EAB200u, 0x3E7B6A00u, 0x58F42200u,
+	0xEF142100u, 0x899B6900u, 0x220AB100u, 0x4485F900u,
+	0xCB864C00u, 0xAD090400u, 0x0698DC00u, 0x60179400u,
+	0xD7F79700u, 0xB178DF00u, 0x1AE90700u, 0x7C664F00u,
+	0x612C4E00u, 0x07A30600u, 0xAC32DE00u, 0xCABD9600u,
+	0x7D5D9500u, 0x1BD2DD00u, 0xB0430500u, 0xD6CC4D00u,
+	0x59CFF800u, 0x3F40B000u, 0x94D16800u, 0xF25E2000u,
+	0x45BE2300u, 0x23316B00u, 0x88A0B300u, 0xEE2FFB00u,
+	0x10EB2200u, 0x76646A00u, 0xDDF5B200u, 0xBB7AFA00u,
+	0x0C9AF900u, 0x6A15B100u, 0xC1846900u, 0xA70B2100u,
+	0x28089400u, 0x4E87DC00u, 0xE5160400u, 0x83994C00u,
+	0x34794F00u, 0x52F60700u, 0xF967DF00u, 0x9FE89700u,
+	0xC3F3DD00u, 0xA57C9500u, 0x0EED4D00u, 0x68620500u,
+	0xDF820600u, 0xB90D4E00u, 0x129C9600u, 0x7413DE00u,
+	0xFB106B00u, 0x9D9F2300u, 0x360EFB00u, 0x5081B300u,
+	0xE761B000u, 0x81EEF800u, 0x2A7F2000u, 0x4CF06800u,
+	0xB234B100u, 0xD4BBF900u, 0x7F2A2100u, 0x19A56900u,
+	0xAE456A00u, 0xC8CA2200u, 0x635BFA00u, 0x05D4B200u,
+	0x8AD70700u, 0xEC584F00u, 0x47C99700u, 0x2146DF00u,
+	0x96A6DC00u, 0xF0299400u, 0x5BB84C00u, 0x3D370400u,
+	0x207D0500u, 0x46F24D00u, 0xED639500u, 0x8BECDD00u,
+	0x3C0CDE00u, 0x5A839600u, 0xF1124E00u, 0x979D0600u,
+	0x189EB300u, 0x7E11FB00u, 0xD5802300u, 0xB30F6B00u,
+	0x04EF6800u, 0x62602000u, 0xC9F1F800u, 0xAF7EB000u,
+	0x51BA6900u, 0x37352100u, 0x9CA4F900u, 0xFA2BB100u,
+	0x4DCBB200u, 0x2B44FA00u, 0x80D52200u, 0xE65A6A00u,
+	0x6959DF00u, 0x0FD69700u, 0xA4474F00u, 0xC2C80700u,
+	0x75280400u, 0x13A74C00u, 0xB8369400u, 0xDEB9DC00u,
+    },
+    {
+	0x00000000u, 0x8309D700u, 0x805F5500u, 0x03568200u,
+	0x86F25100u, 0x05FB8600u, 0x06AD0400u, 0x85A4D300u,
+	0x8BA85900u, 0x08A18E00u, 0x0BF70C00u, 0x88FEDB00u,
+	0x0D5A0800u, 0x8E53DF00u, 0x8D055D00u, 0x0E0C8A00u,
+	0x911C4900u, 0x12159E00u, 0x11431C00u, 0x924ACB00u,
+	0x17EE1800u, 0x94E7CF00u, 0x97B14D00u, 0x14B89A00u,
+	0x1AB41000u, 0x99BDC700u, 0x9AEB4500u, 0x19E29200u,
+	0x9C464100u, 0x1F4F9600u, 0x1C191400u, 0x9F10C300u,
+	0xA4746900u, 0x277DBE00u, 0x242B3C00u, 0xA722EB00u,
+	0x22863800u, 0xA18FEF00u, 0xA2D96D00u, 0x21D0BA00u,
+	0x2FDC3000u, 0xACD5E700u, 0xAF836500u, 0x2C8AB200u,
+	0xA92E6100u, 0x2A27B600u, 0x29713400u, 0xAA78E300u,
+	0x35682000u, 0xB661F700u, 0xB5377500u, 0x363EA200u,
+	0xB39A7100u, 0x3093A600u, 0x33C52400u, 0xB0CCF300u,
+	0xBEC07900u, 0x3DC9AE00u, 0x3E9F2C00u, 0xBD96FB00u,
+	0x38322800u, 0xBB3BFF00u, 0xB86D7D00u, 0x3B64AA00u,
+	0xCEA42900u, 0x4DADFE00u, 0x4EFB7C00u, 0xCDF2AB00u,
+	0x48567800u, 0xCB5FAF00u, 0xC8092D00u, 0x4B00FA00u,
+	0x450C7000u, 0xC605A700u, 0xC5532500u, 0x465AF200u,
+	0xC3FE2100u, 0x40F7F600u, 0x43A17400u, 0xC0A8A300u,
+	0x5FB86000u, 0xDCB1B700u, 0xDFE73500u, 0x5CEEE200u,
+	0xD94A3100u, 0x5A43E600u, 0x59156400u, 0xDA1CB300u,
+	0xD4103900u, 0x5719EE00u, 0x544F6C00u, 0xD746BB00u,
+	0x52E26800u, 0xD1EBBF00u, 0xD2BD3D00u, 0x51B4EA00u,
+	0x6AD04000u, 0xE9D99700u, 0xEA8F1500u, 0x6986C200u,
+	0xEC221100u, 0x6F2BC600u, 0x6C7D4400u, 0xEF749300u,
+	0xE1781900u, 0x6271CE00u, 0x61274C00u, 0xE22E9B00u,
+	0x678A4800u, 0xE4839F00u, 0xE7D51D00u, 0x64DCCA00u,
+	0xFBCC0900u, 0x78C5DE00u, 0x7B935C00u, 0xF89A8B00u,
+	0x7D3E5800u, 0xFE378F00u, 0xFD610D00u, 0x7E68DA00u,
+	0x70645000u, 0xF36D8700u, 0xF03B0500u, 0x7332D200u,
+	0xF6960100u, 0x759FD600u, 0x76C95400u, 0xF5C08300u,
+	0x1B04A900u, 0x980D7E00u, 0x9B5BFC00u, 0x18522B00u,
+	0x9DF6F800u, 0x1EFF2F00u, 0x1DA9AD00u, 0x9EA07A00u,
+	0x90ACF000u, 0x13A52700u, 0x10F3A500u, 0x93FA7200u,
+	0x165EA100u, 0x95577600u, 0x9601F400u, 0x15082300u,
+	0x8A18E000u, 0x09113700u, 0x0A47B500u, 0x894E6200u,
+	0x0CEAB100u, 0x8FE36600u, 0x8CB5E400u, 0x0FBC3300u,
+	0x01B0B900u, 0x82B96E00u, 0x81EFEC00u, 0x02E63B00u,
+	0x8742E800u, 0x044B3F00u, 0x071DBD00u, 0x84146A00u,
+	0xBF70C000u, 0x3C791700u, 0x3F2F9500u, 0xBC264200u,
+	0x39829100u, 0xBA8B4600u, 0xB9DDC400u, 0x3AD41300u,
+	0x34D89900u, 0xB7D14E00u, 0xB487CC00u, 0x378E1B00u,
+	0xB22AC800u, 0x31231F00u, 0x32759D00u, 0xB17C4A00u,
+	0x2E6C8900u, 0xAD655E00u, 0xAE33DC00u, 0x2D3A0B00u,
+	0xA89ED800u, 0x2B970F00u, 0x28C18D00u, 0xABC85A00u,
+	0xA5C4D000u, 0x26CD0700u, 0x259B8500u, 0xA6925200u,
+	0x23368100u, 0xA03F5600u, 0xA369D400u, 0x20600300u,
+	0xD5A08000u, 0x56A95700u, 0x55FFD500u, 0xD6F60200u,
+	0x5352D100u, 0xD05B0600u, 0xD30D8400u, 0x50045300u,
+	0x5E08D900u, 0xDD010E00u, 0xDE578C00u, 0x5D5E5B00u,
+	0xD8FA8800u, 0x5BF35F00u, 0x58A5DD00u, 0xDBAC0A00u,
+	0x44BCC900u, 0xC7B51E00u, 0xC4E39C00u, 0x47EA4B00u,
+	0xC24E9800u, 0x41474F00u, 0x4211CD00u, 0xC1181A00u,
+	0xCF149000u, 0x4C1D4700u, 0x4F4BC500u, 0xCC421200u,
+	0x49E6C100u, 0xCAEF1600u, 0xC9B99400u, 0x4AB04300u,
+	0x71D4E900u, 0xF2DD3E00u, 0xF18BBC00u, 0x72826B00u,
+	0xF726B800u, 0x742F6F00u, 0x7779ED00u, 0xF4703A00u,
+	0xFA7CB000u, 0x79756700u, 0x7A23E500u, 0xF92A3200u,
+	0x7C8EE100u, 0xFF873600u, 0xFCD1B400u, 0x7FD86300u,
+	0xE0C8A000u, 0x63C17700u, 0x6097F500u, 0xE39E2200u,
+	0x663AF100u, 0xE5332600u, 0xE665A400u, 0x656C7300u,
+	0x6B60F900u, 0xE8692E00u, 0xEB3FAC00u, 0x68367B00u,
+	0xED92A800u, 0x6E9B7F00u, 0x6DCDFD00u, 0xEEC42A00u,
+    },
+    {
+	0x00000000u, 0x36095200u, 0x6C12A400u, 0x5A1BF600u,
+	0xD8254800u, 0xEE2C1A00u, 0xB437EC00u, 0x823EBE00u,
+	0x36066B00u, 0x000F3900u, 0x5A14CF00u, 0x6C1D9D00u,
+	0xEE232300u, 0xD82A7100u, 0x82318700u, 0xB438D500u,
+	0x6C0CD600u, 0x5A058400u, 0x001E7200u, 0x36172000u,
+	0xB4299E00u, 0x8220CC00u, 0xD83B3A00u, 0xEE326800u,
+	0x5A0ABD00u, 0x6C03EF00u, 0x36181900u, 0x00114B00u,
+	0x822FF500u, 0xB426A700u, 0xEE3D5100u, 0xD8340300u,
+	0xD819AC00u, 0xEE10FE00u, 0xB40B0800u, 0x82025A00u,
+	0x003CE400u, 0x3635B600u, 0x6C2E4000u, 0x5A271200u,
+	0xEE1FC700u, 0xD8169500u, 0x820D6300u, 0xB4043100u,
+	0x363A8F00u, 0x0033DD00u, 0x5A282B00u, 0x6C217900u,
+	0xB4157A00u, 0x821C2800u, 0xD807DE00u, 0xEE0E8C00u,
+	0x6C303200u, 0x5A396000u, 0x00229600u, 0x362BC400u,
+	0x82131100u, 0xB41A4300u, 0xEE01B500u, 0xD808E700u,
+	0x5A365900u, 0x6C3F0B00u, 0x3624FD00u, 0x002DAF00u,
+	0x367FA300u, 0x0076F100u, 0x5A6D0700u, 0x6C645500u,
+	0xEE5AEB00u, 0xD853B900u, 0x82484F00u, 0xB4411D00u,
+	0x0079C800u, 0x36709A00u, 0x6C6B6C00u, 0x5A623E00u,
+	0xD85C8000u, 0xEE55D200u, 0xB44E2400u, 0x82477600u,
+	0x5A737500u, 0x6C7A2700u, 0x3661D100u, 0x00688300u,
+	0x82563D00u, 0xB45F6F00u, 0xEE449900u, 0xD84DCB00u,
+	0x6C751E00u, 0x5A7C4C00u, 0x0067BA00u, 0x366EE800u,
+	0xB4505600u, 0x82590400u, 0xD842F200u, 0xEE4BA000u,
+	0xEE660F00u, 0xD86F5D00u, 0x8274AB00u, 0xB47DF900u,
+	0x36434700u, 0x004A1500u, 0x5A51E300u, 0x6C58B100u,
+	0xD8606400u, 0xEE693600u, 0xB472C000u, 0x827B9200u,
+	0x00452C00u, 0x364C7E00u, 0x6C578800u, 0x5A5EDA00u,
+	0x826AD900u, 0xB4638B00u, 0xEE787D00u, 0xD8712F00u,
+	0x5A4F9100u, 0x6C46C300u, 0x365D3500u, 0x00546700u,
+	0xB46CB200u, 0x8265E000u, 0xD87E1600u, 0xEE774400u,
+	0x6C49FA00u, 0x5A40A800u, 0x005B5E00u, 0x36520C00u,
+	0x6CFF4600u, 0x5AF61400u, 0x00EDE200u, 0x36E4B000u,
+	0xB4DA0E00u, 0x82D35C00u, 0xD8C8AA00u, 0xEEC1F800u,
+	0x5AF92D00u, 0x6CF07F00u, 0x36EB8900u, 0x00E2DB00u,
+	0x82DC6500u, 0xB4D53700u, 0xEECEC100u, 0xD8C79300u,
+	0x00F39000u, 0x36FAC200u, 0x6CE13400u, 0x5AE86600u,
+	0xD8D6D800u, 0xEEDF8A00u, 0xB4C47C00u, 0x82CD2E00u,
+	0x36F5FB00u, 0x00FCA900u, 0x5AE75F00u, 0x6CEE0D00u,
+	0xEED0B300u, 0xD8D9E100u, 0x82C21700u, 0xB4CB4500u,
+	0xB4E6EA00u, 0x82EFB800u, 0xD8F44E00u, 0xEEFD1C00u,
+	0x6CC3A200u, 0x5ACAF000u, 0x00D10600u, 0x36D85400u,
+	0x82E08100u, 0xB4E9D300u, 0xEEF22500u, 0xD8FB7700u,
+	0x5AC5C900u, 0x6CCC9B00u, 0x36D76D00u, 0x00DE3F00u,
+	0xD8EA3C00u, 0xEEE36E00u, 0xB4F89800u, 0x82F1CA00u,
+	0x00CF7400u, 0x36C62600u, 0x6CDDD000u, 0x5AD48200u,
+	0xEEEC5700u, 0xD8E50500u, 0x82FEF300u, 0xB4F7A100u,
+	0x36C91F00u, 0x00C04D00u, 0x5ADBBB00u, 0x6CD2E900u,
+	0x5A80E500u, 0x6C89B700u, 0x36924100u, 0x009B1300u,
+	0x82A5AD00u, 0xB4ACFF00u, 0xEEB70900u, 0xD8BE5B00u,
+	0x6C868E00u, 0x5A8FDC00u, 0x00942A00u, 0x369D7800u,
+	0xB4A3C600u, 0x82AA9400u, 0xD8B16200u, 0xEEB83000u,
+	0x368C3300u, 0x00856100u, 0x5A9E9700u, 0x6C97C500u,
+	0xEEA97B00u, 0xD8A02900u, 0x82BBDF00u, 0xB4B28D00u,
+	0x008A5800u, 0x36830A00u, 0x6C98FC00u, 0x5A91AE00u,
+	0xD8AF1000u, 0xEEA64200u, 0xB4BDB400u, 0x82B4E600u,
+	0x82994900u, 0xB4901B00u, 0xEE8BED00u, 0xD882BF00u,
+	0x5ABC0100u, 0x6CB55300u, 0x36AEA500u, 0x00A7F700u,
+	0xB49F2200u, 0x82967000u, 0xD88D8600u, 0xEE84D400u,
+	0x6CBA6A00u, 0x5AB33800u, 0x00A8CE00u, 0x36A19C00u,
+	0xEE959F00u, 0xD89CCD00u, 0x82873B00u, 0xB48E6900u,
+	0x36B0D700u, 0x00B98500u, 0x5AA27300u, 0x6CAB2100u,
+	0xD893F400u, 0xEE9AA600u, 0xB4815000u, 0x82880200u,
+	0x00B6BC00u, 0x36BFEE00u, 0x6CA41800u, 0x5AAD4A00u,
+    },
+    {
+	0x00000000u, 0xD9FE8C00u, 0x35B1E300u, 0xEC4F6F00u,
+	0x6B63C600u, 0xB29D4A00u, 0x5ED22500u, 0x872CA900u,
+	0xD6C78C00u, 0x0F390000u, 0xE3766F00u, 0x3A88E300u,
+	0xBDA44A00u, 0x645AC600u, 0x8815A900u, 0x51EB2500u,
+	0x2BC3E300u, 0xF23D6F00u, 0x1E720000u, 0xC78C8C00u,
+	0x40A02500u, 0x995EA900u, 0x7511C600u, 0xACEF4A00u,
+	0xFD046F00u, 0x24FAE300u, 0xC8B58C00u, 0x114B0000u,
+	0x9667A900u, 0x4F992500u, 0xA3D64A00u, 0x7A28C600u,
+	0x5787C600u, 0x8E794A00u, 0x62362500u, 0xBBC8A900u,
+	0x3CE40000u, 0xE51A8C00u, 0x0955E300u, 0xD0AB6F00u,
+	0x81404A00u, 0x58BEC600u, 0xB4F1A900u, 0x6D0F2500u,
+	0xEA238C00u, 0x33DD0000u, 0xDF926F00u, 0x066CE300u,
+	0x7C442500u, 0xA5BAA900u, 0x49F5C600u, 0x900B4A00u,
+	0x1727E300u, 0xCED96F00u, 0x22960000u, 0xFB688C00u,
+	0xAA83A900u, 0x737D2500u, 0x9F324A00u, 0x46CCC600u,
+	0xC1E06F00u, 0x181EE300u, 0xF4518C00u, 0x2DAF0000u,
+	0xAF0F8C00u, 0x76F10000u, 0x9ABE6F00u, 0x4340E300u,
+	0xC46C4A00u, 0x1D92C600u, 0xF1DDA900u, 0x28232500u,
+	0x79C80000u, 0xA0368C00u, 0x4C79E300u, 0x95876F00u,
+	0x12ABC600u, 0xCB554A00u, 0x271A2500u, 0xFEE4A900u,
+	0x84CC6F00u, 0x5D32E300u, 0xB17D8C00u, 0x68830000u,
+	0xEFAFA900u, 0x36512500u, 0xDA1E4A00u, 0x03E0C600u,
+	0x520BE300u, 0x8BF56F00u, 0x67BA0000u, 0xBE448C00u,
+	0x39682500u, 0xE096A900u, 0x0CD9C600u, 0xD5274A00u,
+	0xF8884A00u, 0x2176C600u, 0xCD39A900u, 0x14C72500u,
+	0x93EB8C00u, 0x4A150000u, 0xA65A6F00u, 0x7FA4E300u,
+	0x2E4FC600u, 0xF7B14A00u, 0x1BFE2500u, 0xC200A900u,
+	0x452C0000u, 0x9CD28C00u, 0x709DE300u, 0xA9636F00u,
+	0xD34BA900u, 0x0AB52500u, 0xE6FA4A00u, 0x3F04C600u,
+	0xB8286F00u, 0x61D6E300u, 0x8D998C00u, 0x54670000u,
+	0x058C2500u, 0xDC72A900u, 0x303DC600u, 0xE9C34A00u,
+	0x6EEFE300u, 0xB7116F00u, 0x5B5E0000u, 0x82A08C00u,
+	0xD853E300u, 0x01AD6F00u, 0xEDE20000u, 0x341C8C00u,
+	0xB3302500u, 0x6ACEA900u, 0x8681C600u, 0x5F7F4A00u,
+	0x0E946F00u, 0xD76AE300u, 0x3B258C00u, 0xE2DB0000u,
+	0x65F7A900u, 0xBC092500u, 0x50464A00u, 0x89B8C600u,
+	0xF3900000u, 0x2A6E8C00u, 0xC621E300u, 0x1FDF6F00u,
+	0x98F3C600u, 0x410D4A00u, 0xAD422500u, 0x74BCA900u,
+	0x25578C00u, 0xFCA90000u, 0x10E66F00u, 0xC918E300u,
+	0x4E344A00u, 0x97CAC600u, 0x7B85A900u, 0xA27B2500u,
+	0x8FD42500u, 0x562AA900u, 0xBA65C600u, 0x639B4A00u,
+	0xE4B7E300u, 0x3D496F00u, 0xD1060000u, 0x08F88C00u,
+	0x5913A900u, 0x80ED2500u, 0x6CA24A00u, 0xB55CC600u,
+	0x32706F00u, 0xEB8EE300u, 0x07C18C00u, 0xDE3F0000u,
+	0xA417C600u, 0x7DE94A00u, 0x91A62500u, 0x4858A900u,
+	0xCF740000u, 0x168A8C00u, 0xFAC5E300u, 0x233B6F00u,
+	0x72D04A00u, 0xAB2EC600u, 0x4761A900u, 0x9E9F2500u,
+	0x19B38C00u, 0xC04D0000u, 0x2C026F00u, 0xF5FCE300u,
+	0x775C6F00u, 0xAEA2E300u, 0x42ED8C00u, 0x9B130000u,
+	0x1C3FA900u, 0xC5C12500u, 0x298E4A00u, 0xF070C600u,
+	0xA19BE300u, 0x78656F00u, 0x942A0000u, 0x4DD48C00u,
+	0xCAF82500u, 0x1306A900u, 0xFF49C600u, 0x26B74A00u,
+	0x5C9F8C00u, 0x85610000u, 0x692E6F00u, 0xB0D0E300u,
+	0x37FC4A00u, 0xEE02C600u, 0x024DA900u, 0xDBB32500u,
+	0x8A580000u, 0x53A68C00u, 0xBFE9E300u, 0x66176F00u,
+	0xE13BC600u, 0x38C54A00u, 0xD48A2500u, 0x0D74A900u,
+	0x20DBA900u, 0xF9252500u, 0x156A4A00u, 0xCC94C600u,
+	0x4BB86F00u, 0x9246E300u, 0x7E098C00u, 0xA7F70000u,
+	0xF61C2500u, 0x2FE2A900u, 0xC3ADC600u, 0x1A534A00u,
+	0x9D7FE300u, 0x44816F00u, 0xA8CE0000u, 0x71308C00u,
+	0x0B184A00u, 0xD2E6C600u, 0x3EA9A900u, 0xE7572500u,
+	0x607B8C00u, 0xB9850000u, 0x55CA6F00u, 0x8C34E300u,
+	0xDDDFC600u, 0x04214A00u, 0xE86E2500u, 0x3190A900u,
+	0xB6BC0000u, 0x6F428C00u, 0x830DE300u, 0x5AF36F00u,
+    },
+    {
+	0x00000000u, 0x36EB3D00u, 0x6DD67A00u, 0x5B3D4700u,
+	0xDBACF400u, 0xED47C900u, 0xB67A8E00u, 0x8091B300u,
+	0x31151300u, 0x07FE2E00u, 0x5CC36900u, 0x6A285400u,
+	0xEAB9E700u, 0xDC52DA00u, 0x876F9D00u, 0xB184A000u,
+	0x622A2600u, 0x54C11B00u, 0x0FFC5C00u, 0x39176100u,
+	0xB986D200u, 0x8F6DEF00u, 0xD450A800u, 0xE2BB9500u,
+	0x533F3500u, 0x65D40800u, 0x3EE94F00u, 0x08027200u,
+	0x8893C100u, 0xBE78FC00u, 0xE545BB00u, 0xD3AE8600u,
+	0xC4544C00u, 0xF2BF7100u, 0xA9823600u, 0x9F690B00u,
+	0x1FF8B800u, 0x29138500u, 0x722EC200u, 0x44C5FF00u,
+	0xF5415F00u, 0xC3AA6200u, 0x98972500u, 0xAE7C1800u,
+	0x2EEDAB00u, 0x18069600u, 0x433BD100u, 0x75D0EC00u,
+	0xA67E6A00u, 0x90955700u, 0xCBA81000u, 0xFD432D00u,
+	0x7DD29E00u, 0x4B39A300u, 0x1004E400u, 0x26EFD900u,
+	0x976B7900u, 0xA1804400u, 0xFABD0300u, 0xCC563E00u,
+	0x4CC78D00u, 0x7A2CB000u, 0x2111F700u, 0x17FACA00u,
+	0x0EE46300u, 0x380F5E00u, 0x63321900u, 0x55D92400u,
+	0xD5489700u, 0xE3A3AA00u, 0xB89EED00u, 0x8E75D000u,
+	0x3FF17000u, 0x091A4D00u, 0x52270A00u, 0x64CC3700u,
+	0xE45D8400u, 0xD2B6B900u, 0x898BFE00u, 0xBF60C300u,
+	0x6CCE4500u, 0x5A257800u, 0x01183F00u, 0x37F30200u,
+	0xB762B100u, 0x81898C00u, 0xDAB4CB00u, 0xEC5FF600u,
+	0x5DDB5600u, 0x6B306B00u, 0x300D2C00u, 0x06E61100u,
+	0x8677A200u, 0xB09C9F00u, 0xEBA1D800u, 0xDD4AE500u,
+	0xCAB02F00u, 0xFC5B1200u, 0xA7665500u, 0x918D6800u,
+	0x111CDB00u, 0x27F7E600u, 0x7CCAA100u, 0x4A219C00u,
+	0xFBA53C00u, 0xCD4E0100u, 0x96734600u, 0xA0987B00u,
+	0x2009C800u, 0x16E2F500u, 0x4DDFB200u, 0x7B348F00u,
+	0xA89A0900u, 0x9E713400u, 0xC54C7300u, 0xF3A74E00u,
+	0x7336FD00u, 0x45DDC000u, 0x1EE08700u, 0x280BBA00u,
+	0x998F1A00u, 0xAF642700u, 0xF4596000u, 0xC2B25D00u,
+	0x4223EE00u, 0x74C8D300u, 0x2FF59400u, 0x191EA900u,
+	0x1DC8C600u, 0x2B23FB00u, 0x701EBC00u, 0x46F58100u,
+	0xC6643200u, 0xF08F0F00u, 0xABB24800u, 0x9D597500u,
+	0x2CDDD500u, 0x1A36E800u, 0x410BAF00u, 0x77E09200u,
+	0xF7712100u, 0xC19A1C00u, 0x9AA75B00u, 0xAC4C6600u,
+	0x7FE2E000u, 0x4909DD00u, 0x12349A00u, 0x24DFA700u,
+	0xA44E1400u, 0x92A52900u, 0xC9986E00u, 0xFF735300u,
+	0x4EF7F300u, 0x781CCE00u, 0x23218900u, 0x15CAB400u,
+	0x955B0700u, 0xA3B03A00u, 0xF88D7D00u, 0xCE664000u,
+	0xD99C8A00u, 0xEF77B700u, 0xB44AF000u, 0x82A1CD00u,
+	0x02307E00u, 0x34DB4300u, 0x6FE60400u, 0x590D3900u,
+	0xE8899900u, 0xDE62A400u, 0x855FE300u, 0xB3B4DE00u,
+	0x33256D00u, 0x05CE5000u, 0x5EF31700u, 0x68182A00u,
+	0xBBB6AC00u, 0x8D5D9100u, 0xD660D600u, 0xE08BEB00u,
+	0x601A5800u, 0x56F16500u, 0x0DCC2200u, 0x3B271F00u,
+	0x8AA3BF00u, 0xBC488200u, 0xE775C500u, 0xD19EF800u,
+	0x510F4B00u, 0x67E47600u, 0x3CD93100u, 0x0A320C00u,
+	0x132CA500u, 0x25C79800u, 0x7EFADF00u, 0x4811E200u,
+	0xC8805100u, 0xFE6B6C00u, 0xA5562B00u, 0x93BD1600u,
+	0x2239B600u, 0x14D28B00u, 0x4FEFCC00u, 0x7904F100u,
+	0xF9954200u, 0xCF7E7F00u, 0x94433800u, 0xA2A80500u,
+	0x71068300u, 0x47EDBE00u, 0x1CD0F900u, 0x2A3BC400u,
+	0xAAAA7700u, 0x9C414A00u, 0xC77C0D00u, 0xF1973000u,
+	0x40139000u, 0x76F8AD00u, 0x2DC5EA00u, 0x1B2ED700u,
+	0x9BBF6400u, 0xAD545900u, 0xF6691E00u, 0xC0822300u,
+	0xD778E900u, 0xE193D400u, 0xBAAE9300u, 0x8C45AE00u,
+	0x0CD41D00u, 0x3A3F2000u, 0x61026700u, 0x57E95A00u,
+	0xE66DFA00u, 0xD086C700u, 0x8BBB8000u, 0xBD50BD00u,
+	0x3DC10E00u, 0x0B2A3300u, 0x50177400u, 0x66FC4900u,
+	0xB552CF00u, 0x83B9F200u, 0xD884B500u, 0xEE6F8800u,
+	0x6EFE3B00u, 0x58150600u, 0x03284100u, 0x35C37C00u,
+	0x8447DC00u, 0xB2ACE100u, 0xE991A600u, 0xDF7A9B00u,
+	0x5FEB2800u, 0x69001500u, 0x323D5200u, 0x04D66F00u,
+    },
+    {
+	0x00000000u, 0x3B918C00u, 0x77231800u, 0x4CB29400u,
+	0xEE463000u, 0xD5D7BC00u, 0x99652800u, 0xA2F4A400u,
+	0x5AC09B00u, 0x61511700u, 0x2DE38300u, 0x16720F00u,
+	0xB486AB00u, 0x8F172700u, 0xC3A5B300u, 0xF8343F00u,
+	0xB5813600u, 0x8E10BA00u, 0xC2A22E00u, 0xF933A200u,
+	0x5BC70600u, 0x60568A00u, 0x2CE41E00u, 0x17759200u,
+	0xEF41AD00u, 0xD4D02100u, 0x9862B500u, 0xA3F33900u,
+	0x01079D00u, 0x3A961100u, 0x76248500u, 0x4DB50900u,
+	0xED4E9700u, 0xD6DF1B00u, 0x9A6D8F00u, 0xA1FC0300u,
+	0x0308A700u, 0x38992B00u, 0x742BBF00u, 0x4FBA3300u,
+	0xB78E0C00u, 0x8C1F8000u, 0xC0AD1400u, 0xFB3C9800u,
+	0x59C83C00u, 0x6259B000u, 0x2EEB2400u, 0x157AA800u,
+	0x58CFA100u, 0x635E2D00u, 0x2FECB900u, 0x147D3500u,
+	0xB6899100u, 0x8D181D00u, 0xC1AA8900u, 0xFA3B0500u,
+	0x020F3A00u, 0x399EB600u, 0x752C2200u, 0x4EBDAE00u,
+	0xEC490A00u, 0xD7D88600u, 0x9B6A1200u, 0xA0FB9E00u,
+	0x5CD1D500u, 0x67405900u, 0x2BF2CD00u, 0x10634100u,
+	0xB297E500u, 0x89066900u, 0xC5B4FD00u, 0xFE257100u,
+	0x06114E00u, 0x3D80C200u, 0x71325600u, 0x4AA3DA00u,
+	0xE8577E00u, 0xD3C6F200u, 0x9F746600u, 0xA4E5EA00u,
+	0xE950E300u, 0xD2C16F00u, 0x9E73FB00u, 0xA5E27700u,
+	0x0716D300u, 0x3C875F00u, 0x7035CB00u, 0x4BA44700u,
+	0xB3907800u, 0x8801F400u, 0xC4B36000u, 0xFF22EC00u,
+	0x5DD64800u, 0x6647C400u, 0x2AF55000u, 0x1164DC00u,
+	0xB19F4200u, 0x8A0ECE00u, 0xC6BC5A00u, 0xFD2DD600u,
+	0x5FD97200u, 0x6448FE00u, 0x28FA6A00u, 0x136BE600u,
+	0xEB5FD900u, 0xD0CE5500u, 0x9C7CC100u, 0xA7ED4D00u,
+	0x0519E900u, 0x3E886500u, 0x723AF100u, 0x49AB7D00u,
+	0x041E7400u, 0x3F8FF800u, 0x733D6C00u, 0x48ACE000u,
+	0xEA584400u, 0xD1C9C800u, 0x9D7B5C00u, 0xA6EAD000u,
+	0x5EDEEF00u, 0x654F6300u, 0x29FDF700u, 0x126C7B00u,
+	0xB098DF00u, 0x8B095300u, 0xC7BBC700u, 0xFC2A4B00u,
+	0xB9A3AA00u, 0x82322600u, 0xCE80B200u, 0xF5113E00u,
+	0x57E59A00u, 0x6C741600u, 0x20C68200u, 0x1B570E00u,
+	0xE3633100u, 0xD8F2BD00u, 0x94402900u, 0xAFD1A500u,
+	0x0D250100u, 0x36B48D00u, 0x7A061900u, 0x41979500u,
+	0x0C229C00u, 0x37B31000u, 0x7B018400u, 0x40900800u,
+	0xE264AC00u, 0xD9F52000u, 0x9547B400u, 0xAED63800u,
+	0x56E20700u, 0x6D738B00u, 0x21C11F00u, 0x1A509300u,
+	0xB8A43700u, 0x8335BB00u, 0xCF872F00u, 0xF416A300u,
+	0x54ED3D00u, 0x6F7CB100u, 0x23CE2500u, 0x185FA900u,
+	0xBAAB0D00u, 0x813A8100u, 0xCD881500u, 0xF6199900u,
+	0x0E2DA600u, 0x35BC2A00u, 0x790EBE00u, 0x429F3200u,
+	0xE06B9600u, 0xDBFA1A00u, 0x97488E00u, 0xACD90200u,
+	0xE16C0B00u, 0xDAFD8700u, 0x964F1300u, 0xADDE9F00u,
+	0x0F2A3B00u, 0x34BBB700u, 0x78092300u, 0x4398AF00u,
+	0xBBAC9000u, 0x803D1C00u, 0xCC8F8800u, 0xF71E0400u,
+	0x55EAA000u, 0x6E7B2C00u, 0x22C9B800u, 0x19583400u,
+	0xE5727F00u, 0xDEE3F300u, 0x92516700u, 0xA9C0EB00u,
+	0x0B344F00u, 0x30A5C300u, 0x7C175700u, 0x4786DB00u,
+	0xBFB2E400u, 0x84236800u, 0xC891FC00u, 0xF3007000u,
+	0x51F4D400u, 0x6A655800u, 0x26D7CC00u, 0x1D464000u,
+	0x50F34900u, 0x6B62C500u, 0x27D05100u, 0x1C41DD00u,
+	0xBEB57900u, 0x8524F500u, 0xC9966100u, 0xF207ED00u,
+	0x0A33D200u, 0x31A25E00u, 0x7D10CA00u, 0x46814600u,
+	0xE475E200u, 0xDFE46E00u, 0x9356FA00u, 0xA8C77600u,
+	0x083CE800u, 0x33AD6400u, 0x7F1FF000u, 0x448E7C00u,
+	0xE67AD800u, 0xDDEB5400u, 0x9159C000u, 0xAAC84C00u,
+	0x52FC7300u, 0x696DFF00u, 0x25DF6B00u, 0x1E4EE700u,
+	0xBCBA4300u, 0x872BCF00u, 0xCB995B00u, 0xF008D700u,
+	0xBDBDDE00u, 0x862C5200u, 0xCA9EC600u, 0xF10F4A00u,
+	0x53FBEE00u, 0x686A6200u, 0x24D8F600u, 0x1F497A00u,
+	0xE77D4500u, 0xDCECC900u, 0x905E5D00u, 0xABCFD100u,
+	0x093B7500u, 0x32AAF900u, 0x7E186D00u, 0x4589E100u,
+    },
+    {
+	0x00000000u, 0xF50BAF00u, 0x6C5BA500u, 0x99500A00u,
+	0xD8B74A00u, 0x2DBCE500u, 0xB4ECEF00u, 0x41E74000u,
+	0x37226F00u, 0xC229C000u, 0x5B79CA00u, 0xAE726500u,
+	0xEF952500u, 0x1A9E8A00u, 0x83CE8000u, 0x76C52F00u,
+	0x6E44DE00u, 0x9B4F7100u, 0x021F7B00u, 0xF714D400u,
+	0xB6F39400u, 0x43F83B00u, 0xDAA83100u, 0x2FA39E00u,
+	0x5966B100u, 0xAC6D1E00u, 0x353D1400u, 0xC036BB00u,
+	0x81D1FB00u, 0x74DA5400u, 0xED8A5E00u, 0x1881F100u,
+	0xDC89BC00u, 0x29821300u, 0xB0D21900u, 0x45D9B600u,
+	0x043EF600u, 0xF1355900u, 0x68655300u, 0x9D6EFC00u,
+	0xEBABD300u, 0x1EA07C00u, 0x87F07600u, 0x72FBD900u,
+	0x331C9900u, 0xC6173600u, 0x5F473C00u, 0xAA4C9300u,
+	0xB2CD6200u, 0x47C6CD00u, 0xDE96C700u, 0x2B9D6800u,
+	0x6A7A2800u, 0x9F718700u, 0x06218D00u, 0xF32A2200u,
+	0x85EF0D00u, 0x70E4A200u, 0xE9B4A800u, 0x1CBF0700u,
+	0x5D584700u, 0xA853E800u, 0x3103E200u, 0xC4084D00u,
+	0x3F5F8300u, 0xCA542C00u, 0x53042600u, 0xA60F8900u,
+	0xE7E8C900u, 0x12E36600u, 0x8BB36C00u, 0x7EB8C300u,
+	0x087DEC00u, 0xFD764300u, 0x64264900u, 0x912DE600u,
+	0xD0CAA600u, 0x25C10900u, 0xBC910300u, 0x499AAC00u,
+	0x511B5D00u, 0xA410F200u, 0x3D40F800u, 0xC84B5700u,
+	0x89AC1700u, 0x7CA7B800u, 0xE5F7B200u, 0x10FC1D00u,
+	0x66393200u, 0x93329D00u, 0x0A629700u, 0xFF693800u,
+	0xBE8E7800u, 0x4B85D700u, 0xD2D5DD00u, 0x27DE7200u,
+	0xE3D63F00u, 0x16DD9000u, 0x8F8D9A00u, 0x7A863500u,
+	0x3B617500u, 0xCE6ADA00u, 0x573AD000u, 0xA2317F00u,
+	0xD4F45000u, 0x21FFFF00u, 0xB8AFF500u, 0x4DA45A00u,
+	0x0C431A00u, 0xF948B500u, 0x6018BF00u, 0x95131000u,
+	0x8D92E100u, 0x78994E00u, 0xE1C94400u, 0x14C2EB00u,
+	0x5525AB00u, 0xA02E0400u, 0x397E0E00u, 0xCC75A100u,
+	0xBAB08E00u, 0x4FBB2100u, 0xD6EB2B00u, 0x23E08400u,
+	0x6207C400u, 0x970C6B00u, 0x0E5C6100u, 0xFB57CE00u,
+	0x7EBF0600u, 0x8BB4A900u, 0x12E4A300u, 0xE7EF0C00u,
+	0xA6084C00u, 0x5303E300u, 0xCA53E900u, 0x3F584600u,
+	0x499D6900u, 0xBC96C600u, 0x25C6CC00u, 0xD0CD6300u,
+	0x912A2300u, 0x64218C00u, 0xFD718600u, 0x087A2900u,
+	0x10FBD800u, 0xE5F07700u, 0x7CA07D00u, 0x89ABD200u,
+	0xC84C9200u, 0x3D473D00u, 0xA4173700u, 0x511C9800u,
+	0x27D9B700u, 0xD2D21800u, 0x4B821200u, 0xBE89BD00u,
+	0xFF6EFD00u, 0x0A655200u, 0x93355800u, 0x663EF700u,
+	0xA236BA00u, 0x573D1500u, 0xCE6D1F00u, 0x3B66B000u,
+	0x7A81F000u, 0x8F8A5F00u, 0x16DA5500u, 0xE3D1FA00u,
+	0x9514D500u, 0x601F7A00u, 0xF94F7000u, 0x0C44DF00u,
+	0x4DA39F00u, 0xB8A83000u, 0x21F83A00u, 0xD4F39500u,
+	0xCC726400u, 0x3979CB00u, 0xA029C100u, 0x55226E00u,
+	0x14C52E00u, 0xE1CE8100u, 0x789E8B00u, 0x8D952400u,
+	0xFB500B00u, 0x0E5BA400u, 0x970BAE00u, 0x62000100u,
+	0x23E74100u, 0xD6ECEE00u, 0x4FBCE400u, 0xBAB74B00u,
+	0x41E08500u, 0xB4EB2A00u, 0x2DBB2000u, 0xD8B08F00u,
+	0x9957CF00u, 0x6C5C6000u, 0xF50C6A00u, 0x0007C500u,
+	0x76C2EA00u, 0x83C94500u, 0x1A994F00u, 0xEF92E000u,
+	0xAE75A000u, 0x5B7E0F00u, 0xC22E0500u, 0x3725AA00u,
+	0x2FA45B00u, 0xDAAFF400u, 0x43FFFE00u, 0xB6F45100u,
+	0xF7131100u, 0x0218BE00u, 0x9B48B400u, 0x6E431B00u,
+	0x18863400u, 0xED8D9B00u, 0x74DD9100u, 0x81D63E00u,
+	0xC0317E00u, 0x353AD100u, 0xAC6ADB00u, 0x59617400u,
+	0x9D693900u, 0x68629600u, 0xF1329C00u, 0x04393300u,
+	0x45DE7300u, 0xB0D5DC00u, 0x2985D600u, 0xDC8E7900u,
+	0xAA4B5600u, 0x5F40F900u, 0xC610F300u, 0x331B5C00u,
+	0x72FC1C00u, 0x87F7B300u, 0x1EA7B900u, 0xEBAC1600u,
+	0xF32DE700u, 0x06264800u, 0x9F764200u, 0x6A7DED00u,
+	0x2B9AAD00u, 0xDE910200u, 0x47C10800u, 0xB2CAA700u,
+	0xC40F8800u, 0x31042700u, 0xA8542D00u, 0x5D5F8200u,
+	0x1CB8C200u, 0xE9B36D00u, 0x70E36700u, 0x85E8C800u,
+    },
+};
+
+static unsigned crc24q_bytewise(unsigned crc,
+				const unsigned char *data, size_t len)
 {
-    int i;
-    unsigned crc = 0;
+    size_t i;
 
     for (i = 0; i < len; i++) {
 	crc = (crc << 8) ^ crc24q[data[i] ^ (unsigned char)(crc >> 16)];
     }
+    return crc & 0x00ffffff;
+}
+
+static unsigned crc24q_sliced(unsigned crc24,
+			      const unsigned char *data, size_t len)
+{
+    uint32_t crc = (uint32_t)crc24 << 8;
+
+    for (; len >= 8; data += 8, len -= 8) {
+	uint32_t hi = crc ^ (((uint32_t)data[0] << 24)
+			     | ((uint32_t)data[1] << 16)
+			     | ((uint32_t)data[2] << 8) | data[3]);
+
+	crc = slice[7][hi >> 24] ^ slice[6][(hi >> 16) & 0xff]
+	    ^ slice[5][(hi >> 8) & 0xff] ^ slice[4][hi & 0xff]
+	    ^ slice[3][data[4]] ^ slice[2][data[5]]
+	    ^ slice[1][data[6]] ^ slice[0][data[7]];
+    }
+    return crc24q_bytewise(crc >> 8, data, len);
+}
 
-    crc = (crc & 0x00ffffff);
+/* below this the loop overhead isn't worth it */
+#define CRC24Q_SLICE_MIN	16
 
-    return crc;
+unsigned crc24q_hash(const unsigned char *data, int len)
+{
+    if (len <= 0)
+	return 0;
+    if (len < CRC24Q_SLICE_MIN)
+	return crc24q_bytewise(0, data, (size_t)len);
+    return crc24q_sliced(0, data, (size_t)len);
 }
 
 #define LO(x)	(unsigned char)((x) & 0xff)
@@ -170,7 +755,7 @@ void crc24q_sign(unsigned char *data, int len)
 }
 #endif /* __UNUSED__ */
 
-bool crc24q_check(unsigned char *data, int len)
+bool crc24q_check(const unsigned char *data, int len)
 {
     unsigned crc = crc24q_hash(data, len - 3);
 
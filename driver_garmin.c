@@ -1350,6 +1350,7 @@ static int GetPacket(struct gps_device_t *session)
     gpsd_log(&session->context->errout, LOG_RAW,
 	     "Garmin: GotPacket() sz=%d \n",
 	     session->driver.garmin.BufferLen);
+    session->lexer.frame = session->driver.garmin.Buffer;
     session->lexer.outbuflen = session->driver.garmin.BufferLen;
     return 0;
 }
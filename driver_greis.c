@@ -54,11 +54,12 @@ static const char enable_messages_4hz[] =
  * Handle the message [RE] Reply
  */
 static gps_mask_t greis_msg_RE(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
-    if (0 == memcmp(buf, "%ver%", 5)) {
-        strlcpy(session->subtype, (const char*)&buf[5],
-	        sizeof(session->subtype));
+    if (len >= 5 && 0 == memcmp(buf, "%ver%", 5)) {
+	/* the packet is not NUL-terminated */
+	(void)snprintf(session->subtype, sizeof(session->subtype), "%.*s",
+		       (int)(len - 5), (const char *)&buf[5]);
 	gpsd_log(&session->context->errout, LOG_DATA,
 		 "GREIS: RE, ->subtype: %s\n", session->subtype);
         return DEVICEID_SET;
@@ -73,7 +74,7 @@ static gps_mask_t greis_msg_RE(struct gps_device_t *session,
  * Handle the message [ER] Reply
  */
 static gps_mask_t greis_msg_ER(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     gpsd_log(&session->context->errout, LOG_WARN,
 	     "GREIS: ER %3zd, reply: %.*s\n", len, (int)len, buf);
@@ -84,7 +85,7 @@ static gps_mask_t greis_msg_ER(struct gps_device_t *session,
  * Handle the message [~~](RT) Receiver Time.
  */
 static gps_mask_t greis_msg_RT(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     if (len < 5) {
 	gpsd_log(&session->context->errout, LOG_WARN,
@@ -110,7 +111,7 @@ static gps_mask_t greis_msg_RT(struct gps_device_t *session,
  * Handle the message [UO] GPS UTC Time Parameters.
  */
 static gps_mask_t greis_msg_UO(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     /*
      * For additional details on these parameters and the computation done using
@@ -162,7 +163,7 @@ static gps_mask_t greis_msg_UO(struct gps_device_t *session,
  * Handle the message [GT] GPS Time.
  */
 static gps_mask_t greis_msg_GT(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     uint32_t tow;	     /* Time of week [ms] */
     uint16_t wn;	     /* GPS week number (modulo 1024) [dimensionless] */
@@ -195,7 +196,7 @@ static gps_mask_t greis_msg_GT(struct gps_device_t *session,
  * Handle the message [PV] Cartesian Position and Velocity.
  */
 static gps_mask_t greis_msg_PV(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     double x, y, z;	    /* Cartesian coordinates [m] */
     float p_sigma;	    /* Position spherical error probability (SEP) [m] */
@@ -267,7 +268,7 @@ static gps_mask_t greis_msg_PV(struct gps_device_t *session,
  * Handle the message [SG] Position and Velocity RMS Errors.
  */
 static gps_mask_t greis_msg_SG(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     float hpos;			/* Horizontal position RMS error [m] */
     float vpos;			/* Vertical position RMS error [m] */
@@ -313,7 +314,7 @@ static gps_mask_t greis_msg_SG(struct gps_device_t *session,
  * Note that fill_dop() will handle the unset dops later.
  */
 static gps_mask_t greis_msg_DP(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     if (len < 18) {
 	gpsd_log(&session->context->errout, LOG_WARN,
@@ -346,7 +347,7 @@ static gps_mask_t greis_msg_DP(struct gps_device_t *session,
  * Universal Satellite Identifier (USI).
  */
 static gps_mask_t greis_msg_SI(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     int i;
 
@@ -411,7 +412,7 @@ static gps_mask_t greis_msg_SI(struct gps_device_t *session,
  * Handle the message [EL] Satellite Elevations.
  */
 static gps_mask_t greis_msg_EL(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     int i;
 
@@ -450,7 +451,7 @@ static gps_mask_t greis_msg_EL(struct gps_device_t *session,
  * Handle the message [AZ] Satellite Azimuths.
  */
 static gps_mask_t greis_msg_AZ(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     int i;
 
@@ -491,7 +492,7 @@ static gps_mask_t greis_msg_AZ(struct gps_device_t *session,
  * EC really outputs CNR, but what gpsd refers to as SNR _is_ CNR.
  */
 static gps_mask_t greis_msg_EC(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     int i;
 
@@ -522,7 +523,7 @@ static gps_mask_t greis_msg_EC(struct gps_device_t *session,
  * Handle the message [SS] Satellite Navigation Status.
  */
 static gps_mask_t greis_msg_SS(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     int i;
     int used_count = 0;
@@ -575,7 +576,7 @@ static gps_mask_t greis_msg_SS(struct gps_device_t *session,
  * This should be kept as the last message in each epoch.
  */
 static gps_mask_t greis_msg_ET(struct gps_device_t *session,
-			       unsigned char *buf, size_t len)
+			       const unsigned char *buf, size_t len)
 {
     uint32_t tod;
     gps_mask_t mask = 0;
@@ -643,7 +644,8 @@ static gps_mask_t greis_msg_ET(struct gps_device_t *session,
 struct dispatch_table_entry {
     char id0;
     char id1;
-    gps_mask_t (*handler)(struct gps_device_t *, unsigned char *, size_t);
+    gps_mask_t (*handler)(struct gps_device_t *, const unsigned char *,
+			  size_t);
 };
 
 static struct dispatch_table_entry dispatch_table[] = {
@@ -669,7 +671,7 @@ static struct dispatch_table_entry dispatch_table[] = {
  * Parse the data from the device
  */
 static gps_mask_t greis_dispatch(struct gps_device_t *session,
-				 unsigned char *buf, size_t len)
+				 const unsigned char *buf, size_t len)
 {
     size_t i;
     char id0, id1;
@@ -859,7 +861,7 @@ static void greis_event_hook(struct gps_device_t *session, event_t event)
 static gps_mask_t greis_parse_input(struct gps_device_t *session)
 {
     if (session->lexer.type == GREIS_PACKET) {
-	return greis_dispatch(session, session->lexer.outbuffer,
+	return greis_dispatch(session, session->lexer.frame,
 			      session->lexer.outbuflen);
 #ifdef NMEA0183_ENABLE
     } else if (session->lexer.type == NMEA_PACKET) {
@@ -9,10 +9,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <math.h>
 #include <string.h>
 #include <stdarg.h>
 #include <time.h>
+#include <pthread.h>
 
 #include "gpsd.h"
 #include "strfuncs.h"
@@ -24,6 +26,91 @@
  *
  **************************************************************************/
 
+/*
+ * Field parsers for the sentences that arrive every cycle.  NMEA
+ * numbers are almost always plain decimals, so these take them apart
+ * in integer arithmetic and only fall back to safe_atof() for anything
+ * more exotic.
+ */
+static const double nmea_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+};
+#define NMEA_FRAC_DIGITS	9	/* fraction digits kept; more are dropped */
+
+static int nmea_int(const char *fld)
+/* atoi() for NMEA fields: blanks, an optional sign, decimal digits */
+{
+    int val = 0;
+    bool neg = false;
+
+    while (*fld == ' ')
+	fld++;
+    if (*fld == '-' || *fld == '+')
+	neg = (*fld++ == '-');
+    while (*fld >= '0' && *fld <= '9')
+	val = val * 10 + (*fld++ - '0');
+    return neg ? -val : val;
+}
+
+static bool nmea_fixed(const char *fld, long *whole, long *frac, int *digits)
+/*
+ * Split an unsigned decimal field such as ddmm.mmmm or hhmmss.ss into
+ * its integer part and its fraction as digits over 10^digits.  False
+ * if the field is empty or anything but digits and one point.
+ */
+{
+    const char *p = fld;
+
+    *whole = *frac = 0;
+    *digits = 0;
+    for (; *p >= '0' && *p <= '9'; p++) {
+	if (*whole > LONG_MAX / 10 - 9)
+	    return false;
+	*whole = *whole * 10 + (*p - '0');
+    }
+    if (*p == '.')
+	for (p++; *p >= '0' && *p <= '9'; p++)
+	    if (*digits < NMEA_FRAC_DIGITS) {
+		*frac = *frac * 10 + (*p - '0');
+		++*digits;
+	    }
+    return *p == '\0' && p != fld;
+}
+
+static double nmea_decimal(const char *fld)
+/* safe_atof() for NMEA fields, fast on plain signed decimals */
+{
+    long whole, frac;
+    int digits;
+    const char *p = fld;
+
+    if (*p == '-' || *p == '+')
+	p++;
+    if (!nmea_fixed(p, &whole, &frac, &digits))
+	return safe_atof(fld);
+    if (*fld == '-')
+	return -((double)whole + (double)frac / nmea_pow10[digits]);
+    return (double)whole + (double)frac / nmea_pow10[digits];
+}
+
+static double nmea_degrees(const char *fld)
+/* an NMEA ddmm.mmmm or dddmm.mmmm field in decimal degrees */
+{
+    long whole, frac;
+    int digits;
+    double d, m, val;
+    char str[20];
+
+    if (nmea_fixed(fld, &whole, &frac, &digits))
+	return (double)(whole / 100)
+	    + ((double)(whole % 100) + (double)frac / nmea_pow10[digits])
+	    / 60.0;
+    (void)strlcpy(str, fld, sizeof(str));
+    val = safe_atof(str);
+    m = 100.0 * modf(val / 100.0, &d);
+    return d + m / 60.0;
+}
+
 static void do_lat_lon(char *field[], struct gps_fix_t *out)
 /* process a pair of latitude/longitude fields starting at field index BEGIN
  * The input fields look like this:
@@ -36,26 +123,17 @@ static void do_lat_lon(char *field[], struct gps_fix_t *out)
  *
  */
 {
-    double d, m;
-    char str[20], *p;
+    char *p;
 
     if (*(p = field[0]) != '\0') {
-	double lat;
-	(void)strlcpy(str, p, sizeof(str));
-	lat = safe_atof(str);
-	m = 100.0 * modf(lat / 100.0, &d);
-	lat = d + m / 60.0;
+	double lat = nmea_degrees(p);
 	p = field[1];
 	if (*p == 'S')
 	    lat = -lat;
 	out->latitude = lat;
     }
     if (*(p = field[2]) != '\0') {
-	double lon;
-	(void)strlcpy(str, p, sizeof(str));
-	lon = safe_atof(str);
-	m = 100.0 * modf(lon / 100.0, &d);
-	lon = d + m / 60.0;
+	double lon = nmea_degrees(p);
 
 	p = field[3];
 	if (*p == 'W')
@@ -115,14 +193,19 @@ static void merge_hhmmss(char *hhmmss, struct gps_device_t *session)
 /* update from a UTC time */
 {
     int old_hour = session->nmea.date.tm_hour;
+    long whole, frac;
+    int digits;
 
     session->nmea.date.tm_hour = DD(hhmmss);
     if (session->nmea.date.tm_hour < old_hour)	/* midnight wrap */
 	session->nmea.date.tm_mday++;
     session->nmea.date.tm_min = DD(hhmmss + 2);
     session->nmea.date.tm_sec = DD(hhmmss + 4);
-    session->nmea.subseconds =
-	safe_atof(hhmmss + 4) - session->nmea.date.tm_sec;
+    if (nmea_fixed(hhmmss, &whole, &frac, &digits))
+	session->nmea.subseconds = (double)frac / nmea_pow10[digits];
+    else
+	session->nmea.subseconds =
+	    safe_atof(hhmmss + 4) - session->nmea.date.tm_sec;
 }
 
 static void register_fractional_time(const char *tag, const char *fld,
@@ -130,7 +213,7 @@ static void register_fractional_time(const char *tag, const char *fld,
 {
     if (fld[0] != '\0') {
 	session->nmea.last_frac_time = session->nmea.this_frac_time;
-	session->nmea.this_frac_time = safe_atof(fld);
+	session->nmea.this_frac_time = nmea_decimal(fld);
 	session->nmea.latch_frac_time = true;
 	gpsd_log(&session->context->errout, LOG_DATA,
 		 "%s: registers fractional time %.2f\n",
@@ -277,8 +360,8 @@ static gps_mask_t processRMC(int count, char *field[],
 	}
 	do_lat_lon(&field[3], &session->newdata);
 	mask |= LATLON_SET;
-	session->newdata.speed = safe_atof(field[7]) * KNOTS_TO_MPS;
-	session->newdata.track = safe_atof(field[8]);
+	session->newdata.speed = nmea_decimal(field[7]) * KNOTS_TO_MPS;
+	session->newdata.track = nmea_decimal(field[8]);
 	mask |= (TRACK_SET | SPEED_SET);
 	/*
 	 * This copes with GPSes like the Magellan EC-10X that *only* emit
@@ -431,7 +514,7 @@ static gps_mask_t processGGA(int c UNUSED, char *field[],
      */
     gps_mask_t mask;
 
-    session->gpsdata.status = atoi(field[6]);
+    session->gpsdata.status = nmea_int(field[6]);
     mask = STATUS_SET;
     /*
      * There are some receivers (the Trimble Placer 450 is an example) that
@@ -483,7 +566,7 @@ static gps_mask_t processGGA(int c UNUSED, char *field[],
                 mask |= MODE_SET;
 	    }
 	} else {
-	    session->newdata.altitude = safe_atof(altitude);
+	    session->newdata.altitude = nmea_decimal(altitude);
 	    mask |= ALTITUDE_SET;
 	    /*
 	     * This is a bit dodgy.  Technically we shouldn't set the mode
@@ -498,7 +581,7 @@ static gps_mask_t processGGA(int c UNUSED, char *field[],
 	    }
 	}
 	if (strlen(field[11]) > 0) {
-	    session->gpsdata.separation = safe_atof(field[11]);
+	    session->gpsdata.separation = nmea_decimal(field[11]);
 	} else {
 	    session->gpsdata.separation =
 		wgs84_separation(session->newdata.latitude,
@@ -721,7 +804,7 @@ static gps_mask_t processGSA(int count, char *field[],
 	mask = ONLINE_SET;
     } else {
 	int i;
-	session->newdata.mode = atoi(field[2]);
+	session->newdata.mode = nmea_int(field[2]);
 	/*
 	 * The first arm of this conditional ignores dead-reckoning
 	 * fixes from an Antaris chipset. which returns E in field 2
@@ -734,11 +817,11 @@ static gps_mask_t processGSA(int count, char *field[],
 	gpsd_log(&session->context->errout, LOG_PROG,
 		 "xxGSA sets mode %d\n", session->newdata.mode);
 	if (field[15][0] != '\0')
-	    session->gpsdata.dop.pdop = safe_atof(field[15]);
+	    session->gpsdata.dop.pdop = nmea_decimal(field[15]);
 	if (field[16][0] != '\0')
-	    session->gpsdata.dop.hdop = safe_atof(field[16]);
+	    session->gpsdata.dop.hdop = nmea_decimal(field[16]);
 	if (field[17][0] != '\0')
-	    session->gpsdata.dop.vdop = safe_atof(field[17]);
+	    session->gpsdata.dop.vdop = nmea_decimal(field[17]);
 	/*
 	 * might have gone from GPGSA to GLGSA/BDGSA
 	 * or GNGSA to GNGSA
@@ -880,8 +963,8 @@ static gps_mask_t processGSV(int count, char *field[],
 	return ONLINE_SET;
     }
 
-    session->nmea.await = atoi(field[1]);
-    if ((session->nmea.part = atoi(field[2])) < 1) {
+    session->nmea.await = nmea_int(field[1]);
+    if ((session->nmea.part = nmea_int(field[2])) < 1) {
 	gpsd_log(&session->context->errout, LOG_WARN,
 		 "malformed GPGSV - bad part\n");
 	gpsd_zero_satellites(&session->gpsdata);
@@ -918,11 +1001,11 @@ static gps_mask_t processGSV(int count, char *field[],
 	    break;
 	}
 	sp = &session->gpsdata.skyview[session->gpsdata.satellites_visible];
-	svid = atoi(field[fldnum++]);
+	svid = nmea_int(field[fldnum++]);
 	sp->PRN = (short)nmeaid_to_prn(field[0], svid, &sp->gnssid, &sp->svid);
-	sp->elevation = (short)atoi(field[fldnum++]);
-	sp->azimuth = (short)atoi(field[fldnum++]);
-	sp->ss = (float)atoi(field[fldnum++]);
+	sp->elevation = (short)nmea_int(field[fldnum++]);
+	sp->azimuth = (short)nmea_int(field[fldnum++]);
+	sp->ss = (float)nmea_int(field[fldnum++]);
 	sp->used = false;
 	if (sp->PRN > 0)
 	    for (n = 0; n < MAXCHANNELS; n++)
@@ -1852,85 +1935,162 @@ static gps_mask_t processSTI(int count, char *field[],
 }
 #endif /* SKYTRAQ_ENABLE */
 
-/**************************************************************************
- *
- * Entry points begin here
- *
- **************************************************************************/
+/*
+ * Sentence dispatch.  Tags of up to 8 characters are packed into an
+ * integer and hashed into a small open-addressed index over the phrase
+ * table, so finding the decoder costs the same however many phrases
+ * are compiled in.  The index holds at most 32 phrases, the limit the
+ * cycle_enders bitmask already puts on the table.  It is filled once,
+ * under pthread_once(), because reader threads parse concurrently.
+ */
+#define NMEA_INDEX_SIZE	64	/* a power of 2, at least twice the table */
 
-gps_mask_t nmea_parse(char *sentence, struct gps_device_t * session)
-/* parse an NMEA sentence, unpack it into a session structure */
+static struct {
+    uint64_t key;
+    int phrase;			/* phrase table index + 1, 0 if unused */
+} nmea_index[NMEA_INDEX_SIZE];
+
+static uint64_t nmea_tag_key(const char *tag, size_t len)
+/* pack a tag into an integer; 0 if it is too long to be in the table */
 {
-    typedef gps_mask_t(*nmea_decoder) (int count, char *f[],
-				       struct gps_device_t * session);
-    static struct
-    {
-	char *name;
-	int nf;			/* minimum number of fields required to parse */
-	bool cycle_continue;	/* cycle continuer? */
-	nmea_decoder decoder;
-    } nmea_phrase[] = {
-	{"PGRMC", 0, false, NULL},	/* ignore Garmin Sensor Config */
-	{"PGRME", 7, false, processPGRME},
-	{"PGRMI", 0, false, NULL},	/* ignore Garmin Sensor Init */
-	{"PGRMO", 0, false, NULL},	/* ignore Garmin Sentence Enable */
-	    /*
-	     * Basic sentences must come after the PG* ones, otherwise
-	     * Garmins can get stuck in a loop that looks like this:
-	     *
-	     * 1. A Garmin GPS in NMEA mode is detected.
-	     *
-	     * 2. PGRMC is sent to reconfigure to Garmin binary mode.
-	     *    If successful, the GPS echoes the phrase.
-	     *
-	     * 3. nmea_parse() sees the echo as RMC because the talker
-	     *    ID is ignored, and fails to recognize the echo as
-	     *    PGRMC and ignore it.
-	     *
-	     * 4. The mode is changed back to NMEA, resulting in an
-	     *    infinite loop.
-	     */
-	{"DBT", 7,  true,  processDBT},
-	{"GBS", 7,  false, processGBS},
-	{"GGA", 13, false, processGGA},
-	{"GLL", 7,  false, processGLL},
-	{"GSA", 17, false, processGSA},
-	{"GST", 8,  false, processGST},
-	{"GSV", 0,  false, processGSV},
-        {"HDT", 1,  false, processHDT},
+    uint64_t key = 0;
+    size_t i;
+
+    if (len > sizeof(key))
+	return 0;
+    for (i = 0; i < len; i++)
+	key = (key << 8) | (unsigned char)tag[i];
+    return key;
+}
+
+static unsigned int nmea_tag_slot(uint64_t key)
+{
+    return (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> 58)
+	& (NMEA_INDEX_SIZE - 1);
+}
+
+static void nmea_index_add(uint64_t key, int phrase)
+{
+    unsigned int slot, probes;
+
+    for (slot = nmea_tag_slot(key), probes = 0; probes < NMEA_INDEX_SIZE;
+	 slot = (slot + 1) & (NMEA_INDEX_SIZE - 1), probes++)
+	if (nmea_index[slot].phrase == 0) {
+	    nmea_index[slot].key = key;
+	    nmea_index[slot].phrase = phrase + 1;
+	    return;
+	}
+    /* can't happen while the table is at most half full */
+}
+
+static int nmea_index_find(uint64_t key)
+/* phrase table index of a packed tag, or -1 */
+{
+    unsigned int slot, probes;
+
+    if (key == 0)
+	return -1;
+    for (slot = nmea_tag_slot(key), probes = 0;
+	 probes < NMEA_INDEX_SIZE && nmea_index[slot].phrase != 0;
+	 slot = (slot + 1) & (NMEA_INDEX_SIZE - 1), probes++)
+	if (nmea_index[slot].key == key)
+	    return nmea_index[slot].phrase - 1;
+    return -1;
+}
+
+typedef gps_mask_t(*nmea_decoder) (int count, char *f[],
+				   struct gps_device_t * session);
+
+static const struct
+{
+    char *name;
+    int nf;			/* minimum number of fields required to parse */
+    bool cycle_continue;	/* cycle continuer? */
+    nmea_decoder decoder;
+} nmea_phrase[] = {
+    {"PGRMC", 0, false, NULL},	/* ignore Garmin Sensor Config */
+    {"PGRME", 7, false, processPGRME},
+    {"PGRMI", 0, false, NULL},	/* ignore Garmin Sensor Init */
+    {"PGRMO", 0, false, NULL},	/* ignore Garmin Sentence Enable */
+        /*
+         * Basic sentences must come after the PG* ones, otherwise
+         * Garmins can get stuck in a loop that looks like this:
+         *
+         * 1. A Garmin GPS in NMEA mode is detected.
+         *
+         * 2. PGRMC is sent to reconfigure to Garmin binary mode.
+         *    If successful, the GPS echoes the phrase.
+         *
+         * 3. nmea_parse() sees the echo as RMC because the talker
+         *    ID is ignored, and fails to recognize the echo as
+         *    PGRMC and ignore it.
+         *
+         * 4. The mode is changed back to NMEA, resulting in an
+         *    infinite loop.
+         */
+    {"DBT", 7,  true,  processDBT},
+    {"GBS", 7,  false, processGBS},
+    {"GGA", 13, false, processGGA},
+    {"GLL", 7,  false, processGLL},
+    {"GSA", 17, false, processGSA},
+    {"GST", 8,  false, processGST},
+    {"GSV", 0,  false, processGSV},
+    {"HDT", 1,  false, processHDT},
 #ifdef OCEANSERVER_ENABLE
-	{"OHPR", 18, false, processOHPR},
+    {"OHPR", 18, false, processOHPR},
 #endif /* OCEANSERVER_ENABLE */
 #ifdef ASHTECH_ENABLE
-        /* general handler for Ashtech */
-	{"PASHR", 3, false, processPASHR},
+    /* general handler for Ashtech */
+    {"PASHR", 3, false, processPASHR},
 #endif /* ASHTECH_ENABLE */
 #ifdef MTK3301_ENABLE
-	{"PMTK", 3,  false, processMTK3301},
-        /* for some reason thhe parser no longer triggering on leading chars */
-	{"PMTK001", 3,  false, processMTK3301},
-	{"PMTK424", 3,  false, processMTK3301},
-	{"PMTK705", 3,  false, processMTK3301},
+    {"PMTK", 3,  false, processMTK3301},
+    /* for some reason thhe parser no longer triggering on leading chars */
+    {"PMTK001", 3,  false, processMTK3301},
+    {"PMTK424", 3,  false, processMTK3301},
+    {"PMTK705", 3,  false, processMTK3301},
 #endif /* MTK3301_ENABLE */
 #ifdef TNT_ENABLE
-	{"PTNTHTM", 9, false, processTNTHTM},
-	{"PTNTA", 8, false, processTNTA},
+    {"PTNTHTM", 9, false, processTNTHTM},
+    {"PTNTA", 8, false, processTNTA},
 #endif /* TNT_ENABLE */
 #ifdef SKYTRAQ_ENABLE
-	{"PSTI", 2, false, processPSTI},	/* $PSTI Skytraq */
-	{"STI", 2, false, processSTI},		/* $STI  Skytraq */
+    {"PSTI", 2, false, processPSTI},	/* $PSTI Skytraq */
+    {"STI", 2, false, processSTI},		/* $STI  Skytraq */
 #endif /* SKYTRAQ_ENABLE */
-	{"RMC", 8,  false, processRMC},
-	{"TXT", 5,  false, processTXT},
-	{"ZDA", 4,  false, processZDA},
-	{"VTG", 5,  false, processVTG},
-    };
+    {"RMC", 8,  false, processRMC},
+    {"TXT", 5,  false, processTXT},
+    {"ZDA", 4,  false, processZDA},
+    {"VTG", 5,  false, processVTG},
+};
+
+static pthread_once_t nmea_index_once = PTHREAD_ONCE_INIT;
+
+static void nmea_index_build(void)
+/* fill the tag index, once, before any thread can look in it */
+{
+    unsigned int i;
+
+    for (i = 0; i < (unsigned)NITEMS(nmea_phrase); ++i)
+	nmea_index_add(nmea_tag_key(nmea_phrase[i].name,
+				    strlen(nmea_phrase[i].name)), (int)i);
+}
 
-    int count;
+/**************************************************************************
+ *
+ * Entry points begin here
+ *
+ **************************************************************************/
+
+gps_mask_t nmea_parse(char *sentence, struct gps_device_t * session)
+/* parse an NMEA sentence, unpack it into a session structure */
+{
+    int count, phrase;
     gps_mask_t retval = 0;
     unsigned int i, thistag;
-    char *p, *e;
-    volatile char *t;
+    size_t taglen;
+    char *p, *e, *tag;
+    const char *s;
 #ifdef SKYTRAQ_ENABLE
     bool skytraq_sti = false;
 #endif
@@ -1943,46 +2103,48 @@ gps_mask_t nmea_parse(char *sentence, struct gps_device_t * session)
      * legal limit for NMEA, so we can cope by just tossing out overlong
      * packets.  This may be a generic bug of all Garmin chipsets.
      */
-    if (strlen(sentence) > NMEA_MAX) {
+    if (strnlen(sentence, NMEA_MAX + 1) > NMEA_MAX) {
 	gpsd_log(&session->context->errout, LOG_WARN,
 		 "Overlong packet of %zd chars rejected.\n",
 		 strlen(sentence));
 	return ONLINE_SET;
     }
 
-    /* make an editable copy of the sentence */
-    (void)strlcpy((char *)session->nmea.fieldcopy, sentence,
-                  sizeof(session->nmea.fieldcopy) - 1);
-    /* discard the checksum part */
-    for (p = (char *)session->nmea.fieldcopy;
-	 (*p != '*') && (*p >= ' ');)
-	++p;
-    if (*p == '*')
-	*p++ = ',';		/* otherwise we drop the last field */
+    /*
+     * Make an editable copy of the sentence and split it on commas in
+     * the same pass, filling the field array.  The checksum part is
+     * discarded; its '*' ends a field like a comma, otherwise we would
+     * drop the last field.
+     */
+    p = (char *)session->nmea.fieldcopy;
+    e = p + sizeof(session->nmea.fieldcopy) - 2;
+    count = 0;
+    session->nmea.field[0] = p + 1;	/* beginning of tag, 'G' not '$' */
+    s = sentence;
+    if (*s >= ' ' && *s != '*')
+	*p++ = *s++;
+    for (; p < e; s++) {
+	if (*s == ',' || *s == '*') {
+	    *p++ = '\0';
+	    session->nmea.field[++count] = p;
+	    if (*s == '*')
+		break;
+	} else if (*s >= ' ')
+	    *p++ = *s;
+	else
+	    break;
+    }
 #ifdef SKYTRAQ_ENABLE_UNUSED
     /* $STI is special, no trailing *, or chacksum */
     if ( 0 != strncmp( "STI,", sentence, 4) ) {
 	skytraq_sti = true;
-	*p++ = ',';		/* otherwise we drop the last field */
+	*p++ = '\0';		/* otherwise we drop the last field */
+	session->nmea.field[++count] = p;
     }
 #endif
     *p = '\0';
     e = p;
 
-    /* split sentence copy on commas, filling the field array */
-    count = 0;
-    t = p;			/* end of sentence */
-    p = (char *)session->nmea.fieldcopy + 1; /* beginning of tag, 'G' not '$' */
-    /* while there is a search string and we haven't run off the buffer... */
-    while ((p != NULL) && (p <= t)) {
-	session->nmea.field[count] = p;	/* we have a field. record it */
-	if ((p = strchr(p, ',')) != NULL) {  /* search for the next delimiter */
-	    *p = '\0';		/* replace it with a NUL */
-	    count++;		/* bump the counters and continue */
-	    p++;
-	}
-    }
-
     /* point remaining fields at empty string, just in case */
     for (i = (unsigned int)count;
 	 i <
@@ -1993,37 +2155,52 @@ gps_mask_t nmea_parse(char *sentence, struct gps_device_t * session)
     /* sentences handlers will tell us when they have fractional time */
     session->nmea.latch_frac_time = false;
 
-    /* dispatch on field zero, the sentence tag */
-    for (thistag = i = 0;
-	 i < (unsigned)(sizeof(nmea_phrase) / sizeof(nmea_phrase[0])); ++i) {
-	char *s = session->nmea.field[0];
-	if (strlen(nmea_phrase[i].name) == 3
+    (void)pthread_once(&nmea_index_once, nmea_index_build);
+
+    /*
+     * Dispatch on field zero, the sentence tag.  Three-character
+     * phrase names match after a two-character talker ID, longer ones
+     * match the whole tag.  Should both match, as PGRMC and RMC do,
+     * the phrase earlier in the table wins.
+     */
+    tag = session->nmea.field[0];
+    taglen = strlen(tag);
+    phrase = -1;
 #ifdef SKYTRAQ_ENABLE
-	        /* $STI is special */
-		&& !skytraq_sti
-#endif
-		) {
-	    s += 2;		/* skip talker ID */
-        }
-	if (strcmp(nmea_phrase[i].name, s) == 0) {
-	    if (nmea_phrase[i].decoder != NULL
-		&& (count >= nmea_phrase[i].nf)) {
-		retval =
-		    (nmea_phrase[i].decoder) (count,
-					      session->nmea.field,
-					      session);
-		if (nmea_phrase[i].cycle_continue)
-		    session->nmea.cycle_continue = true;
-		/*
-		 * Must force this to be nz, as we're going to rely on a zero
-		 * value to mean "no previous tag" later.
-		 */
-		thistag = i + 1;
-	    } else
-		retval = ONLINE_SET;	/* unknown sentence */
-	    break;
+    /* $STI is special */
+    if (skytraq_sti)
+	phrase = nmea_index_find(nmea_tag_key(tag, taglen));
+    else
+#endif /* SKYTRAQ_ENABLE */
+    {
+	if (taglen != 3)
+	    phrase = nmea_index_find(nmea_tag_key(tag, taglen));
+	if (taglen == 5) {
+	    int talked = nmea_index_find(nmea_tag_key(tag + 2, 3));
+
+	    if (talked != -1 && (phrase == -1 || talked < phrase))
+		phrase = talked;
 	}
     }
+    thistag = 0;
+    if (phrase != -1) {
+	i = (unsigned int)phrase;
+	if (nmea_phrase[i].decoder != NULL
+	    && (count >= nmea_phrase[i].nf)) {
+	    retval =
+		(nmea_phrase[i].decoder) (count,
+					  session->nmea.field,
+					  session);
+	    if (nmea_phrase[i].cycle_continue)
+		session->nmea.cycle_continue = true;
+	    /*
+	     * Must force this to be nz, as we're going to rely on a zero
+	     * value to mean "no previous tag" later.
+	     */
+	    thistag = i + 1;
+	} else
+	    retval = ONLINE_SET;	/* unknown sentence */
+    }
 
     /* prevent overaccumulation of sat reports */
     if (!str_starts_with(session->nmea.field[0] + 2, "GSV"))
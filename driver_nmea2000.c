@@ -1416,6 +1416,7 @@ static void find_pgn(struct can_frame *frame, struct gps_device_t *session)
 		    gpsd_log(&session->context->errout, LOG_DATA,
 			     "pgn %6d:%s \n", work->pgn, work->name);
 		    session->driver.nmea2000.workpgn = (void *) work;
+		    session->lexer.frame = session->lexer.outbuffer;
 		    session->lexer.outbuflen =  frame->can_dlc & 0x0f;
 		    for (l2=0;l2<session->lexer.outbuflen;l2++) {
 		        session->lexer.outbuffer[l2]= frame->data[l2];
@@ -1459,6 +1460,7 @@ static void find_pgn(struct can_frame *frame, struct gps_device_t *session)
 				                                                   source_pgn);
 #endif /* of #if  NMEA2000_FAST_DEBUG */
 			session->driver.nmea2000.workpgn = (void *) work;
+		        session->lexer.frame = session->lexer.outbuffer;
 		        session->lexer.outbuflen = session->driver.nmea2000.fast_packet_len;
 			for(l2=0;l2 < (unsigned int)session->lexer.outbuflen; l2++) {
 			    session->lexer.outbuffer[l2] = session->lexer.inbuffer[l2];
@@ -70,7 +70,7 @@ SPDX-License-Identifier: BSD-2-clause
  * and look at the tklib source: http://www.rtklib.com/
  */
 void rtcm3_unpack(const struct gps_context_t *context,
-		  struct rtcm3_t *rtcm, char *buf)
+		  struct rtcm3_t *rtcm, const char *buf)
 /* break out the raw bits into the scaled report-structure fields */
 {
     unsigned int n, n2, n3, n4;
@@ -79,8 +79,8 @@ void rtcm3_unpack(const struct gps_context_t *context,
     signed long temp;
     bool unknown = true;;
 
-#define ugrab(width)	(bitcount += width, ubits((unsigned char *)buf, bitcount-width, width, false))
-#define sgrab(width)	(bitcount += width, sbits((signed char *)buf, bitcount-width, width, false))
+#define ugrab(width)	(bitcount += width, ubits((const unsigned char *)buf, bitcount-width, width, false))
+#define sgrab(width)	(bitcount += width, sbits((const signed char *)buf, bitcount-width, width, false))
 #define GPS_PSEUDORANGE(fld, len) \
     {temp = (unsigned long)ugrab(len);		\
     if (temp == GPS_INVALID_PSEUDORANGE)	\
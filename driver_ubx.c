@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 #include <unistd.h>
 
 #include "gpsd.h"
@@ -57,30 +58,8 @@
 #define UBX_CFG_LEN		20
 #define outProtoMask		14
 
-static gps_mask_t ubx_parse(struct gps_device_t *session, unsigned char *buf,
-			    size_t len);
-static gps_mask_t ubx_msg_nav_eoe(struct gps_device_t *session,
-				  unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_dop(struct gps_device_t *session,
-				  unsigned char *buf, size_t data_len);
-static void ubx_msg_inf(struct gps_device_t *session, unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_posecef(struct gps_device_t *session,
-				      unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_pvt(struct gps_device_t *session,
-				  unsigned char *buf, size_t data_len);
-static void ubx_msg_sbas(struct gps_device_t *session, unsigned char *buf);
-static gps_mask_t ubx_msg_nav_sat(struct gps_device_t *session,
-				  unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_sol(struct gps_device_t *session,
-				  unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_svinfo(struct gps_device_t *session,
-				     unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_timegps(struct gps_device_t *session,
-				      unsigned char *buf, size_t data_len);
-static gps_mask_t ubx_msg_nav_velecef(struct gps_device_t *session,
-				      unsigned char *buf, size_t data_len);
-static void ubx_msg_mon_ver(struct gps_device_t *session,
-				      unsigned char *buf, size_t data_len);
+static gps_mask_t ubx_parse(struct gps_device_t *session,
+			    const unsigned char *buf, size_t len);
 #ifdef RECONFIGURE_ENABLE
 static void ubx_mode(struct gps_device_t *session, int mode);
 #endif /* RECONFIGURE_ENABLE */
@@ -92,35 +71,33 @@ static void ubx_mode(struct gps_device_t *session, int mode);
  * sadly more info than fits in session->swtype for now.
  * so squish the data hard, max is maybe 100?
  */
-static void
-ubx_msg_mon_ver(struct gps_device_t *session, unsigned char *buf,
+static gps_mask_t
+ubx_msg_mon_ver(struct gps_device_t *session, const unsigned char *buf,
 		size_t data_len)
 {
     size_t n = 0;	/* extended info counter */
     char obuf[128];     /* temp version string buffer */
 
-    if ( 44 > data_len ) {
-	/* incomplete message */
-        return;
-    }
-
     /* save SW and HW Version as subtype */
     (void)snprintf(obuf, sizeof(obuf),
 		   "SW %.30s,HW %.10s",
-		   (char *)&buf[UBX_MESSAGE_DATA_OFFSET + 0],
-		   (char *)&buf[UBX_MESSAGE_DATA_OFFSET + 30]);
+		   (char *)&buf[0],
+		   (char *)&buf[30]);
 
     /* get n number of Extended info strings.  what is max n? */
     for ( n = 0; ; n++ ) {
-        size_t start_of_str = UBX_MESSAGE_DATA_OFFSET + 40 + (30 * n);
+        size_t start_of_str = 40 + (30 * n);
+        size_t olen = strlen(obuf);
 
         if ( (start_of_str + 2 ) > data_len ) {
 	    /* last one can be shorter than 30 */
             /* no more data */
             break;
         }
-	(void)strlcat(obuf, ",", sizeof(obuf));
-	(void)strlcat(obuf, (char *)&buf[start_of_str], sizeof(obuf));
+	(void)snprintf(obuf + olen, sizeof(obuf) - olen, ",%.*s",
+		       (int)(data_len - start_of_str < 30
+			     ? data_len - start_of_str : 30),
+		       (char *)&buf[start_of_str]);
     }
     /* save what we can */
     (void)strlcpy(session->subtype, obuf, sizeof(session->subtype));
@@ -129,24 +106,19 @@ ubx_msg_mon_ver(struct gps_device_t *session, unsigned char *buf,
     gpsd_log(&session->context->errout, LOG_INF,
 	     "UBX_MON_VER: %.*s\n",
              (int)sizeof(obuf), obuf);
+    return 0;
 }
 
 /*
  * Navigation Position ECEF message
  */
 static gps_mask_t
-ubx_msg_nav_posecef(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_posecef(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
     gps_mask_t mask = ECEF_SET;
     double fTOW;
 
-    if (data_len < 20) {
-	gpsd_log(&session->context->errout, LOG_WARN,
-		 "Invalid NAV POSECEF message, payload len %zd", data_len);
-	return 0;
-    }
-
     fTOW = getleu32(buf, 0) / 1000.0;
     session->newdata.ecef.x = getles32(buf, 4) / 100.0;
     session->newdata.ecef.y = getles32(buf, 8) / 100.0;
@@ -166,8 +138,8 @@ ubx_msg_nav_posecef(struct gps_device_t *session, unsigned char *buf,
  * Navigation Position Velocity Time  solution message
  */
 static gps_mask_t
-ubx_msg_nav_pvt(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_pvt(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
     uint8_t valid;
     uint8_t flags;
@@ -178,9 +150,6 @@ ubx_msg_nav_pvt(struct gps_device_t *session, unsigned char *buf,
     int *mode = &session->newdata.mode;
     gps_mask_t mask = 0;
 
-    if (data_len != 92)
-	return 0;
-
     valid = (unsigned int)getub(buf, 11);
     navmode = (unsigned char)getub(buf, 20);
     flags = (unsigned int)getub(buf, 21);
@@ -298,16 +267,13 @@ ubx_msg_nav_pvt(struct gps_device_t *session, unsigned char *buf,
  * Navigation solution message: UBX-NAV-SOL
  */
 static gps_mask_t
-ubx_msg_nav_sol(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_sol(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
     unsigned int flags;
     unsigned char navmode;
     gps_mask_t mask;
 
-    if (data_len != 52)
-	return 0;
-
     flags = (unsigned int)getub(buf, 11);
     mask = 0;
 #define DATE_VALID	(UBX_SOL_VALID_WEEK | UBX_SOL_VALID_TIME)
@@ -381,7 +347,8 @@ ubx_msg_nav_sol(struct gps_device_t *session, unsigned char *buf,
     else if (session->newdata.mode != MODE_NO_FIX)
 	session->gpsdata.status = STATUS_FIX;
 
-    mask |= MODE_SET | STATUS_SET;
+    /* UBX-NAV-SOL deprecated, but it still ends the cycle if sent */
+    mask |= MODE_SET | STATUS_SET | REPORT_IS;
     gpsd_log(&session->context->errout, LOG_DATA,
 	     "UBX_NAV_SOL: time=%.2f lat=%.2f lon=%.2f alt=%.2f track=%.2f speed=%.2f climb=%.2f mode=%d status=%d used=%d\n",
 	     session->newdata.time,
@@ -401,7 +368,7 @@ ubx_msg_nav_sol(struct gps_device_t *session, unsigned char *buf,
  * Geodetic position solution message
  */
 static gps_mask_t
-ubx_msg_nav_posllh(struct gps_device_t *session, unsigned char *buf,
+ubx_msg_nav_posllh(struct gps_device_t *session, const unsigned char *buf,
 		   size_t data_len UNUSED)
 {
     session->driver.ubx.last_herr = (double)(getleu32(buf, 20) / 1000.0);
@@ -413,12 +380,9 @@ ubx_msg_nav_posllh(struct gps_device_t *session, unsigned char *buf,
  * Dilution of precision message
  */
 static gps_mask_t
-ubx_msg_nav_dop(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_dop(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
-    if (data_len != 18)
-	return 0;
-
     /*
      * We make a deliberate choice not to clear DOPs from the
      * last skyview here, but rather to treat this as a supplement
@@ -444,14 +408,11 @@ ubx_msg_nav_dop(struct gps_device_t *session, unsigned char *buf,
  * End of Epoch
  */
 static gps_mask_t
-ubx_msg_nav_eoe(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_eoe(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
     long int iTOW;
 
-    if ( 4 > data_len)
-	return 0;
-
     iTOW = getles32(buf, 0);
     gpsd_log(&session->context->errout, LOG_DATA, "EOE: iTOW=%ld\n", iTOW);
     /* nothing really to new, but report data collected so far
@@ -466,15 +427,12 @@ ubx_msg_nav_eoe(struct gps_device_t *session, unsigned char *buf,
  * GPS Leap Seconds - UBX-NAV-TIMEGPS
  */
 static gps_mask_t
-ubx_msg_nav_timegps(struct gps_device_t *session, unsigned char *buf,
-		    size_t data_len)
+ubx_msg_nav_timegps(struct gps_device_t *session, const unsigned char *buf,
+		    size_t data_len UNUSED)
 {
     uint8_t valid;         /* Validity Flags */
     gps_mask_t mask = 0;
 
-    if (data_len != 16)
-	return 0;
-
     valid = getub(buf, 11);
     // Valid leap seconds ?
     if ((valid & UBX_TIMEGPS_VALID_LEAP_SECOND) ==
@@ -511,16 +469,11 @@ ubx_msg_nav_timegps(struct gps_device_t *session, unsigned char *buf,
  * GPS Satellite Info -- new style UBX-NAV-SAT
  */
 static gps_mask_t
-ubx_msg_nav_sat(struct gps_device_t *session, unsigned char *buf,
+ubx_msg_nav_sat(struct gps_device_t *session, const unsigned char *buf,
                 size_t data_len)
 {
     unsigned int i, nchan, nsv, st, ver;
 
-    if (data_len < 8) {
-	gpsd_log(&session->context->errout, LOG_PROG,
-		 "runt NAV-SAT (datalen=%zd)\n", data_len);
-	return 0;
-    }
     ver = (unsigned int)getub(buf, 4);
     if (1 != ver) {
 	gpsd_log(&session->context->errout, LOG_WARN,
@@ -534,17 +487,24 @@ ubx_msg_nav_sat(struct gps_device_t *session, unsigned char *buf,
 		 MAXCHANNELS);
 	return 0;
     }
+    if (data_len < 8 + 12 * nchan) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "runt NAV-SAT (datalen=%zd, %u satellites)\n",
+		 data_len, nchan);
+	return 0;
+    }
     /* two "unused" bytes at buf[6:7] */
 
     gpsd_zero_satellites(&session->gpsdata);
     nsv = 0;
     for (i = st = 0; i < nchan; i++) {
-	unsigned int off = 8 + 12 * i;
+	/* one 12-byte block per satellite, all inside data_len */
+	const unsigned char *sv = buf + 8 + 12 * i;
         short PRN = 0;
-        unsigned char gnssId = getub(buf, off + 0);
-        short svId = (short)getub(buf, off + 1);
-        unsigned char cno = getub(buf, off + 2);
-	uint32_t flags = getleu32(buf, off + 8);
+        unsigned char gnssId = getub(sv, 0);
+        short svId = (short)getub(sv, 1);
+        unsigned char cno = getub(sv, 2);
+	uint32_t flags = getleu32(sv, 8);
 	bool used = (bool)(flags  & 0x08);
 
 	if (0 == svId) {
@@ -626,8 +586,8 @@ ubx_msg_nav_sat(struct gps_device_t *session, unsigned char *buf,
 	session->gpsdata.skyview[st].PRN = PRN;
 
 	session->gpsdata.skyview[st].ss = (float)cno;
-	session->gpsdata.skyview[st].elevation = (short)getsb(buf, off + 3);
-	session->gpsdata.skyview[st].azimuth = (short)getles16(buf, off + 4);
+	session->gpsdata.skyview[st].elevation = (short)getsb(sv, 3);
+	session->gpsdata.skyview[st].azimuth = (short)getles16(sv, 4);
 	session->gpsdata.skyview[st].used = used;
 	if (used || PRN == (short)session->driver.ubx.sbas_in_use) {
 	    nsv++;
@@ -653,16 +613,11 @@ ubx_msg_nav_sat(struct gps_device_t *session, unsigned char *buf,
  * GPS Satellite Info -- deprecated - UBX-NAV-SVINFO
  */
 static gps_mask_t
-ubx_msg_nav_svinfo(struct gps_device_t *session, unsigned char *buf,
+ubx_msg_nav_svinfo(struct gps_device_t *session, const unsigned char *buf,
 		   size_t data_len)
 {
     unsigned int i, nchan, nsv, st;
 
-    if (data_len < 8) {
-	gpsd_log(&session->context->errout, LOG_PROG,
-		 "runt svinfo (datalen=%zd)\n", data_len);
-	return 0;
-    }
     nchan = (unsigned int)getub(buf, 4);
     if (nchan > MAXCHANNELS) {
 	gpsd_log(&session->context->errout, LOG_WARN,
@@ -670,13 +625,20 @@ ubx_msg_nav_svinfo(struct gps_device_t *session, unsigned char *buf,
 		 MAXCHANNELS);
 	return 0;
     }
+    if (data_len < 8 + 12 * nchan) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "runt svinfo (datalen=%zd, %u satellites)\n",
+		 data_len, nchan);
+	return 0;
+    }
     gpsd_zero_satellites(&session->gpsdata);
     nsv = 0;
     for (i = st = 0; i < nchan; i++) {
-	unsigned int off = 8 + 12 * i;
-        short PRN = (short)getub(buf, off + 1);
-        unsigned char snr = getub(buf, off + 4);
-	bool used = (bool)(getub(buf, off + 2) & 0x01);
+	/* one 12-byte block per channel, all inside data_len */
+	const unsigned char *sv = buf + 8 + 12 * i;
+        short PRN = (short)getub(sv, 1);
+        unsigned char snr = getub(sv, 4);
+	bool used = (bool)(getub(sv, 2) & 0x01);
 
         /* fit into gnssid:svid */
 	if (0 == PRN) {
@@ -722,8 +684,8 @@ ubx_msg_nav_svinfo(struct gps_device_t *session, unsigned char *buf,
 	session->gpsdata.skyview[st].PRN = PRN;
 
 	session->gpsdata.skyview[st].ss = (float)snr;
-	session->gpsdata.skyview[st].elevation = (short)getsb(buf, off + 5);
-	session->gpsdata.skyview[st].azimuth = (short)getles16(buf, off + 6);
+	session->gpsdata.skyview[st].elevation = (short)getsb(sv, 5);
+	session->gpsdata.skyview[st].azimuth = (short)getles16(sv, 6);
 	session->gpsdata.skyview[st].used = used;
 	if (used || PRN == (short)session->driver.ubx.sbas_in_use) {
 	    nsv++;
@@ -742,6 +704,15 @@ ubx_msg_nav_svinfo(struct gps_device_t *session, unsigned char *buf,
 	     "SVINFO: visible=%d used=%d mask={SATELLITE|USED}\n",
 	     session->gpsdata.satellites_visible,
 	     session->gpsdata.satellites_used);
+
+    /* this is a hack to move some initialization until after we
+     * get some u-blox message so we know the GPS is alive */
+    if ('\0' == session->subtype[0]) {
+	/* one time only */
+	(void)strlcpy(session->subtype, "Unknown", 8);
+	/* request SW and HW Versions */
+	(void)ubx_write(session, UBX_CLASS_MON, 0x04, NULL, 0);
+    }
     return SATELLITE_SET | USED_IS;
 }
 
@@ -749,18 +720,12 @@ ubx_msg_nav_svinfo(struct gps_device_t *session, unsigned char *buf,
  * Velocity Position ECEF message
  */
 static gps_mask_t
-ubx_msg_nav_velecef(struct gps_device_t *session, unsigned char *buf,
-		size_t data_len)
+ubx_msg_nav_velecef(struct gps_device_t *session, const unsigned char *buf,
+		size_t data_len UNUSED)
 {
     gps_mask_t mask = VECEF_SET;
     double fTOW;
 
-    if (data_len < 20) {
-	gpsd_log(&session->context->errout, LOG_WARN,
-		 "Invalid NAV VELECEF message, payload len %zd", data_len);
-	return 0;
-    }
-
     fTOW = getleu32(buf, 0) / 1000.0;
     session->newdata.ecef.vx = getles32(buf, 4) / 100.0;
     session->newdata.ecef.vy = getles32(buf, 8) / 100.0;
@@ -779,7 +744,9 @@ ubx_msg_nav_velecef(struct gps_device_t *session, unsigned char *buf,
 /*
  * SBAS Info
  */
-static void ubx_msg_sbas(struct gps_device_t *session, unsigned char *buf)
+static gps_mask_t ubx_msg_sbas(struct gps_device_t *session,
+			       const unsigned char *buf,
+			       size_t data_len UNUSED)
 {
 #ifdef __UNUSED_DEBUG__
     unsigned int i, nsv;
@@ -799,6 +766,7 @@ static void ubx_msg_sbas(struct gps_device_t *session, unsigned char *buf)
 /* really 'in_use' depends on the sats info, EGNOS is still in test */
 /* In WAAS areas one might also check for the type of corrections indicated */
     session->driver.ubx.sbas_in_use = (unsigned char)getub(buf, 4);
+    return 0;
 }
 
 /*
@@ -808,57 +776,122 @@ static gps_mask_t ubx_rxm_rawx(struct gps_device_t *session,
                                const unsigned char *buf,
                                size_t data_len)
 {
+    struct rawmeas_t *raw = &session->gpsdata.rawmeas;
     double rcvTow;
     uint16_t week;
     int8_t leapS;
     uint8_t numMeas;
     uint8_t recStat;
-
-    if (16 > data_len) {
-	gpsd_log(&session->context->errout, LOG_WARN,
-		 "Invalid RXM-RAWX message, payload len %zd", data_len);
-	return 0;
-    }
+    int i;
 
     rcvTow = getled64((const char *)buf, 0);
     week = getleu16(buf, 8);
     leapS = getsb(buf, 10);
     numMeas = getub(buf, 11);
     recStat = getub(buf, 12);
+    if (data_len < 16 + 32 * (size_t)numMeas) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "Invalid RXM-RAWX message, payload len %zd for %u "
+		 "measurements\n", data_len, numMeas);
+	return 0;
+    }
 
     gpsd_log(&session->context->errout, LOG_PROG,
 	     "UBX_RXM_RAWX: rcvTow %f week %u leapS %d numMeas %u recStat %d\n",
 	     rcvTow, week, leapS, numMeas, recStat);
 
-    for (int i = 0; i < numMeas; i++) {
-        int off = 32 * i;
-        double prMes = getled64((const char *)buf, off + 16);
-        double cpMes = getled64((const char *)buf, off + 24);
-        double doMes = getlef32((const char *)buf, off + 32);
-        uint8_t gnssId = getub(buf, off + 36);
-        uint8_t svId = getub(buf, off + 37);
-        uint8_t freqId = getub(buf, off + 39);
-        uint16_t locktime = getleu16(buf, off + 40);
-        uint8_t cno = getub(buf, off + 42);
-        uint8_t prStdev = getub(buf, off + 43);
-        uint8_t cpStdev = getub(buf, off + 44);
-        uint8_t doStdev = getub(buf, off + 45);
-        uint8_t trkStat = getub(buf, off + 46);
+    if (numMeas > MAXCHANNELS)
+	numMeas = MAXCHANNELS;
+    raw->mtime = gpsd_gpstime_resolve(session, week, rcvTow);
+
+    /* only the entries in use are written, the rest may be stale */
+    for (i = 0; i < numMeas; i++) {
+	int off = 32 * i;
+	struct meas_t *meas = &raw->meas[i];
+	uint8_t trkStat = getub(buf, off + 46);
+
+	meas->pseudorange = getled64((const char *)buf, off + 16);
+	meas->carrierphase = getled64((const char *)buf, off + 24);
+	meas->doppler = getlef32((const char *)buf, off + 32);
+	meas->gnssid = getub(buf, off + 36);
+	meas->svid = getub(buf, off + 37);
+	meas->sigid = getub(buf, off + 38);
+	meas->freqid = getub(buf, off + 39);
+	meas->locktime = getleu16(buf, off + 40);
+	meas->snr = getub(buf, off + 42);
+	/* trkStat: bit 0 pseudorange valid, bit 1 carrier phase valid */
+	meas->satstat = SAT_ACQUIRED;
+	if ((trkStat & 0x01) != 0)
+	    meas->satstat |= SAT_CODE_TRACK;
+	else
+	    meas->pseudorange = NAN;
+	if ((trkStat & 0x02) != 0)
+	    meas->satstat |= SAT_CARR_TRACK;
+	else
+	    meas->carrierphase = NAN;
 	gpsd_log(&session->context->errout, LOG_DATA,
 		 "%u:%u:%u prMes %f cpMes %f doMes %f locktime %u\n"
 		 "cno %u prStdev %u cpStdev %u doStdev %u rtkStat %u\n",
-		 gnssId, svId, freqId, prMes, cpMes, doMes, locktime,
-		 cno, prStdev, cpStdev, doStdev, trkStat);
+		 meas->gnssid, meas->svid, meas->freqid,
+		 meas->pseudorange, meas->carrierphase, meas->doppler,
+		 meas->locktime, meas->snr,
+		 getub(buf, off + 43), getub(buf, off + 44),
+		 getub(buf, off + 45), trkStat);
     }
+    raw->nmeas = numMeas;
 
-    /* TODO: no place to put this data, yet */
-    return 0;
+    return RAW_SET;
+}
+
+/*
+ * Broadcast navigation data subframes -- UBX-RXM-SFRBX
+ */
+static gps_mask_t ubx_rxm_sfrbx(struct gps_device_t *session,
+				const unsigned char *buf,
+				size_t data_len)
+{
+    unsigned int i, gnssId, svId, numWords;
+    uint32_t words[10];
+
+    gnssId = (unsigned int)getub(buf, 0);
+    svId = (unsigned int)getub(buf, 1);
+    numWords = (unsigned int)getub(buf, 4);
+    if (data_len < 8 + 4 * (size_t)numWords) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "Invalid RXM-SFRBX message, payload len %zd for %u words\n",
+		 data_len, numWords);
+	return 0;
+    }
+    gpsd_log(&session->context->errout, LOG_PROG,
+	     "UBX_RXM_SFRBX: gnssId %u svId %u freqId %u numWords %u "
+	     "chn %u version %u\n",
+	     gnssId, svId, (unsigned int)getub(buf, 3), numWords,
+	     (unsigned int)getub(buf, 5), (unsigned int)getub(buf, 6));
+
+    /* only GPS L1C/A subframes have a decoder */
+    if (gnssId != 0 || numWords != 10)
+	return 0;
+
+    /*
+     * Each word is the 30-bit transmitted word, parity included, with
+     * the top two bits as padding.  Put D29* and D30* of the previous
+     * word there so the parity check can undo the inversion.
+     */
+    for (i = 0; i < 10; i++) {
+	words[i] = (uint32_t)getleu32(buf, 8 + 4 * i) & 0x3fffffff;
+	if (i > 0)
+	    words[i] |= (words[i - 1] & 0x03) << 30;
+    }
+
+    return gpsd_interpret_subframe_raw(session, svId, words);
 }
 
 /*
  * Raw Subframes - UBX-RXM-SFRB
  */
-static gps_mask_t ubx_rxm_sfrb(struct gps_device_t *session, unsigned char *buf)
+static gps_mask_t ubx_rxm_sfrb(struct gps_device_t *session,
+			       const unsigned char *buf,
+			       size_t data_len UNUSED)
 {
     unsigned int i, chan, svid;
     uint32_t words[10];
@@ -876,358 +909,301 @@ static gps_mask_t ubx_rxm_sfrb(struct gps_device_t *session, unsigned char *buf)
     return gpsd_interpret_subframe(session, svid, words);
 }
 
-static void ubx_msg_inf(struct gps_device_t *session, unsigned char *buf,
-                        size_t data_len)
+/*
+ * Informative text messages
+ */
+static void ubx_msg_inf(struct gps_device_t *session, const unsigned char *buf,
+                        size_t data_len, int level, const char *label)
 {
-    unsigned short msgid;
-    static char txtbuf[MAX_PACKET_LENGTH];
+    char txtbuf[MAX_PACKET_LENGTH];
 
-    msgid = (unsigned short)((buf[2] << 8) | buf[3]);
     if (data_len > MAX_PACKET_LENGTH - 1)
 	data_len = MAX_PACKET_LENGTH - 1;
 
-    (void)strlcpy(txtbuf, (char *)buf + UBX_PREFIX_LEN, sizeof(txtbuf));
+    /* the packet is not NUL-terminated */
+    (void)memcpy(txtbuf, buf, data_len);
     txtbuf[data_len] = '\0';
-    switch (msgid) {
-    case UBX_INF_DEBUG:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_INF_DEBUG: %s\n", txtbuf);
-	break;
-    case UBX_INF_TEST:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_INF_TEST: %s\n", txtbuf);
-	break;
-    case UBX_INF_NOTICE:
-	gpsd_log(&session->context->errout, LOG_INF, "UBX_INF_NOTICE: %s\n", txtbuf);
-	break;
-    case UBX_INF_WARNING:
-	gpsd_log(&session->context->errout, LOG_WARN, "UBX_INF_WARNING: %s\n", txtbuf);
-	break;
-    case UBX_INF_ERROR:
-	gpsd_log(&session->context->errout, LOG_WARN, "UBX_INF_ERROR: %s\n", txtbuf);
-	break;
-    default:
-	break;
-    }
-    return;
+    gpsd_log(&session->context->errout, level, "%s: %s\n", label, txtbuf);
 }
 
-gps_mask_t ubx_parse(struct gps_device_t * session, unsigned char *buf,
-		     size_t len)
+static gps_mask_t ubx_msg_inf_debug(struct gps_device_t *session,
+				    const unsigned char *buf, size_t data_len)
 {
-    size_t data_len;
-    unsigned short msgid;
-    gps_mask_t mask = 0;
+    ubx_msg_inf(session, buf, data_len, LOG_PROG, "UBX_INF_DEBUG");
+    return 0;
+}
 
-    /* the packet at least contains a head long enough for an empty message */
-    if (len < UBX_PREFIX_LEN)
-	return 0;
+static gps_mask_t ubx_msg_inf_test(struct gps_device_t *session,
+				   const unsigned char *buf, size_t data_len)
+{
+    ubx_msg_inf(session, buf, data_len, LOG_PROG, "UBX_INF_TEST");
+    return 0;
+}
 
-    session->cycle_end_reliable = true;
+static gps_mask_t ubx_msg_inf_notice(struct gps_device_t *session,
+				     const unsigned char *buf, size_t data_len)
+{
+    ubx_msg_inf(session, buf, data_len, LOG_INF, "UBX_INF_NOTICE");
+    return 0;
+}
 
-    /* extract message id and length */
-    msgid = (buf[2] << 8) | buf[3];
-    data_len = (size_t) getles16(buf, 4);
+static gps_mask_t ubx_msg_inf_warning(struct gps_device_t *session,
+				      const unsigned char *buf,
+				      size_t data_len)
+{
+    ubx_msg_inf(session, buf, data_len, LOG_WARN, "UBX_INF_WARNING");
+    return 0;
+}
 
-    switch (msgid) {
-    case UBX_ACK_ACK:
-	gpsd_log(&session->context->errout, LOG_DATA,
-		 "UBX_ACK_ACK, class: %02x, id: %02x\n",
-		 buf[UBX_CLASS_OFFSET],
-		 buf[UBX_TYPE_OFFSET]);
-	break;
-    case UBX_ACK_NAK:
-	gpsd_log(&session->context->errout, LOG_WARN,
-		 "UBX_ACK_NAK, class: %02x, id: %02x\n",
-		 buf[UBX_CLASS_OFFSET],
-		 buf[UBX_TYPE_OFFSET]);
-	break;
+static gps_mask_t ubx_msg_inf_error(struct gps_device_t *session,
+				    const unsigned char *buf, size_t data_len)
+{
+    ubx_msg_inf(session, buf, data_len, LOG_WARN, "UBX_INF_ERROR");
+    return 0;
+}
+
+/*
+ * Acknowledgements of configuration messages
+ */
+static gps_mask_t ubx_msg_ack_ack(struct gps_device_t *session,
+				  const unsigned char *buf,
+				  size_t data_len UNUSED)
+{
+    gpsd_log(&session->context->errout, LOG_DATA,
+	     "UBX_ACK_ACK, class: %02x, id: %02x\n", buf[0], buf[1]);
+    return 0;
+}
 
-    case UBX_CFG_PRT:
-        if (session->driver.ubx.port_id != buf[UBX_MESSAGE_DATA_OFFSET + 0] ) {
-	    session->driver.ubx.port_id = buf[UBX_MESSAGE_DATA_OFFSET + 0];
-	    gpsd_log(&session->context->errout, LOG_INF,
-		     "UBX_CFG_PRT: port %d\n", session->driver.ubx.port_id);
+static gps_mask_t ubx_msg_ack_nak(struct gps_device_t *session,
+				  const unsigned char *buf,
+				  size_t data_len UNUSED)
+{
+    gpsd_log(&session->context->errout, LOG_WARN,
+	     "UBX_ACK_NAK, class: %02x, id: %02x\n", buf[0], buf[1]);
+    return 0;
+}
+
+/*
+ * Port configuration, as polled by ubx_init_query()
+ */
+static gps_mask_t ubx_msg_cfg_prt(struct gps_device_t *session,
+				  const unsigned char *buf,
+				  size_t data_len UNUSED)
+{
+    if (session->driver.ubx.port_id != buf[0]) {
+	session->driver.ubx.port_id = buf[0];
+	gpsd_log(&session->context->errout, LOG_INF,
+		 "UBX_CFG_PRT: port %d\n", session->driver.ubx.port_id);
 
 #ifdef RECONFIGURE_ENABLE
-	    /* Need to reinitialize since port changed */
-	    if (session->mode == O_OPTIMIZE) {
-		ubx_mode(session, MODE_BINARY);
-	    } else {
-		ubx_mode(session, MODE_NMEA);
-	    }
-#endif /* RECONFIGURE_ENABLE */
+	/* Need to reinitialize since port changed */
+	if (session->mode == O_OPTIMIZE) {
+	    ubx_mode(session, MODE_BINARY);
+	} else {
+	    ubx_mode(session, MODE_NMEA);
 	}
-	break;
+#endif /* RECONFIGURE_ENABLE */
+    }
+    return 0;
+}
 
-    case UBX_INF_DEBUG:
-	/* FALLTHROUGH */
-    case UBX_INF_ERROR:
-	/* FALLTHROUGH */
-    case UBX_INF_NOTICE:
-	/* FALLTHROUGH */
-    case UBX_INF_TEST:
-	/* FALLTHROUGH */
-    case UBX_INF_USER:
-	/* FALLTHROUGH */
-    case UBX_INF_WARNING:
-	ubx_msg_inf(session, buf, data_len);
-	break;
+/*
+ * The messages ubx_parse() knows.  Each decoder is registered with the
+ * payload lengths it accepts, and ubx_parse() checks them before the
+ * call, so a decoder may read any field inside min_len without further
+ * checks.  A max_len of 0 means no upper bound; decoders for messages
+ * with repeated blocks check the block count against data_len
+ * themselves.  Messages with no decoder are only logged.
+ */
+struct ubx_msg_t {
+    unsigned short msgid;
+    const char *name;
+    int loglevel;		/* to log the message's arrival at */
+    size_t min_len, max_len;	/* payload length bounds */
+    gps_mask_t (*decode)(struct gps_device_t *session,
+			 const unsigned char *buf, size_t data_len);
+};
 
-    case UBX_MON_EXCEPT:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_EXCEPT\n");
-	break;
-    case UBX_MON_GNSS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_GNSS\n");
-	break;
-    case UBX_MON_HW:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_HW\n");
-	break;
-    case UBX_MON_HW2:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_HW2\n");
-	break;
-    case UBX_MON_IO:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_IO\n");
-	break;
-    case UBX_MON_IPC:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_IPC\n");
-	break;
-    case UBX_MON_MSGPP:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_MSGPP\n");
-	break;
-    case UBX_MON_PATCH:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_PATCH\n");
-	break;
-    case UBX_MON_RXBUF:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_RXBUF\n");
-	break;
-    case UBX_MON_RXR:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_RXR\n");
-	break;
-    case UBX_MON_SCHED:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_SCHED\n");
-	break;
-    case UBX_MON_SMGR:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_SMGR\n");
-	break;
-    case UBX_MON_TXBUF:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_TXBUF\n");
-	break;
-    case UBX_MON_USB:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_USB\n");
-	break;
-    case UBX_MON_VER:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_MON_VER\n");
-	ubx_msg_mon_ver(session, buf, data_len);
-	break;
+#define UBX_MSG(id, level, min, max, decode)	\
+    {id, #id, level, min, max, decode}
+
+static const struct ubx_msg_t ubx_msgs[] = {
+    UBX_MSG(UBX_ACK_ACK,	LOG_DATA, 2, 0, ubx_msg_ack_ack),
+    UBX_MSG(UBX_ACK_NAK,	LOG_DATA, 2, 0, ubx_msg_ack_nak),
+
+    UBX_MSG(UBX_CFG_PRT,	LOG_DATA, 1, 0, ubx_msg_cfg_prt),
+
+    UBX_MSG(UBX_INF_DEBUG,	LOG_DATA, 0, 0, ubx_msg_inf_debug),
+    UBX_MSG(UBX_INF_ERROR,	LOG_DATA, 0, 0, ubx_msg_inf_error),
+    UBX_MSG(UBX_INF_NOTICE,	LOG_DATA, 0, 0, ubx_msg_inf_notice),
+    UBX_MSG(UBX_INF_TEST,	LOG_DATA, 0, 0, ubx_msg_inf_test),
+    UBX_MSG(UBX_INF_USER,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_INF_WARNING,	LOG_DATA, 0, 0, ubx_msg_inf_warning),
+
+    UBX_MSG(UBX_MON_EXCEPT,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_GNSS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_HW,		LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_HW2,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_IO,		LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_IPC,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_MSGPP,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_PATCH,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_RXBUF,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_RXR,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_SCHED,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_SMGR,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_TXBUF,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_USB,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_MON_VER,	LOG_DATA, 44, 0, ubx_msg_mon_ver),
+
+    UBX_MSG(UBX_NAV_AOPSTATUS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_ATT,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_CLOCK,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_DGPS,	LOG_DATA, 0, 0, NULL),
+    /* DOP seems to be the last NAV sent in a cycle */
+    UBX_MSG(UBX_NAV_DOP,	LOG_PROG, 18, 18, ubx_msg_nav_dop),
+    UBX_MSG(UBX_NAV_EKFSTATUS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_EOE,	LOG_DATA, 4, 0, ubx_msg_nav_eoe),
+    UBX_MSG(UBX_NAV_GEOFENCE,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_HPPOSECEF,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_HPPOSLLH,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_ODO,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_ORB,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_POSECEF,	LOG_DATA, 20, 0, ubx_msg_nav_posecef),
+    UBX_MSG(UBX_NAV_POSLLH,	LOG_DATA, 28, 0, ubx_msg_nav_posllh),
+    UBX_MSG(UBX_NAV_POSUTM,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_PVT,	LOG_PROG, 92, 92, ubx_msg_nav_pvt),
+    UBX_MSG(UBX_NAV_RELPOSNED,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_RESETODO,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_SAT,	LOG_DATA, 8, 0, ubx_msg_nav_sat),
+    UBX_MSG(UBX_NAV_SBAS,	LOG_DATA, 12, 0, ubx_msg_sbas),
+    /* UBX-NAV-SOL deprecated, use UBX-NAV-PVT instead */
+    UBX_MSG(UBX_NAV_SOL,	LOG_PROG, 52, 52, ubx_msg_nav_sol),
+    UBX_MSG(UBX_NAV_STATUS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_SVIN,	LOG_DATA, 0, 0, NULL),
+    /* UBX-NAV-SVINFO deprecated, use UBX-NAV-SAT instead */
+    UBX_MSG(UBX_NAV_SVINFO,	LOG_PROG, 8, 0, ubx_msg_nav_svinfo),
+    UBX_MSG(UBX_NAV_TIMEBDS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_TIMEGAL,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_TIMEGLO,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_TIMEGPS,	LOG_PROG, 16, 16, ubx_msg_nav_timegps),
+    UBX_MSG(UBX_NAV_TIMELS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_TIMEUTC,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_NAV_VELECEF,	LOG_DATA, 20, 0, ubx_msg_nav_velecef),
+    UBX_MSG(UBX_NAV_VELNED,	LOG_DATA, 0, 0, NULL),
+
+    UBX_MSG(UBX_RXM_ALM,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_EPH,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_IMES,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_MEASX,	LOG_PROG, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_PMREQ,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_POSREQ,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_RAW,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_RAWX,	LOG_DATA, 16, 0, ubx_rxm_rawx),
+    UBX_MSG(UBX_RXM_RLM,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_RTCM,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_RXM_SFRB,	LOG_DATA, 42, 0, ubx_rxm_sfrb),
+    UBX_MSG(UBX_RXM_SFRBX,	LOG_PROG, 8, 0, ubx_rxm_sfrbx),
+    UBX_MSG(UBX_RXM_SVSI,	LOG_PROG, 0, 0, NULL),
+
+    UBX_MSG(UBX_TIM_DOSC,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_FCHG,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_HOC,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_SMEAS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_SVIN,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_TM,		LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_TM2,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_TP,		LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_TOS,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_VCOCAL,	LOG_DATA, 0, 0, NULL),
+    UBX_MSG(UBX_TIM_VRFY,	LOG_DATA, 0, 0, NULL),
+};
 
-    case UBX_NAV_AOPSTATUS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_AOPSTATUS\n");
-	break;
-    case UBX_NAV_ATT:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_ATT\n");
-	break;
-    case UBX_NAV_CLOCK:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_CLOCK\n");
-	break;
-    case UBX_NAV_DGPS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_DGPS\n");
-	break;
-    case UBX_NAV_DOP:
-        /* DOP seems to be the last NAV sent in a cycle */
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_NAV_DOP\n");
-	mask = ubx_msg_nav_dop(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_EKFSTATUS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_EKFSTATUS\n");
-	break;
-    case UBX_NAV_EOE:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_EOE\n");
-	mask = ubx_msg_nav_eoe(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_GEOFENCE:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_GEOFENCE\n");
-	break;
-    case UBX_NAV_HPPOSECEF:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_HPPOSECEF\n");
-	break;
-    case UBX_NAV_HPPOSLLH:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_HPPOSLLH\n");
-	break;
-    case UBX_NAV_ODO:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_ODO\n");
-	break;
-    case UBX_NAV_ORB:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_ORB\n");
-	break;
-    case UBX_NAV_POSECEF:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_POSECEF\n");
-	mask = ubx_msg_nav_posecef(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_POSLLH:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_POSLLH\n");
-	mask = ubx_msg_nav_posllh(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_POSUTM:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_POSUTM\n");
-	break;
-    case UBX_NAV_PVT:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_NAV_PVT\n");
-	mask = ubx_msg_nav_pvt(session, &buf[UBX_PREFIX_LEN], data_len);
-        break;
-    case UBX_NAV_RELPOSNED:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_RELPOSNED\n");
-	break;
-    case UBX_NAV_RESETODO:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_RESETODO\n");
-	break;
-    case UBX_NAV_SAT:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_SAT\n");
-	mask = ubx_msg_nav_sat(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_SBAS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_SBAS\n");
-	ubx_msg_sbas(session, &buf[6]);
-	break;
-    case UBX_NAV_SOL:
-        /* UBX-NAV-SOL deprecated, use UBX-NAV-PVT instead */
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_NAV_SOL\n");
-	mask = ubx_msg_nav_sol(session, &buf[UBX_PREFIX_LEN], data_len)
-	     | REPORT_IS;
-	break;
-    case UBX_NAV_STATUS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_STATUS\n");
-	break;
-    case UBX_NAV_SVIN:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_SVIN\n");
-	break;
-    case UBX_NAV_SVINFO:
-        /* UBX-NAV-SVINFO deprecated, use UBX-NAV-SAT instead */
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_NAV_SVINFO\n");
-	mask = ubx_msg_nav_svinfo(session, &buf[UBX_PREFIX_LEN], data_len);
-
-	/* this is a hack to move some initialization until after we
-	 * get some u-blox message so we know the GPS is alive */
-	if ('\0' == session->subtype[0]) {
-	    /* one time only */
-	    (void)strlcpy(session->subtype, "Unknown", 8);
-	    /* request SW and HW Versions */
-	    (void)ubx_write(session, UBX_CLASS_MON, 0x04, NULL, 0);
-	}
+#undef UBX_MSG
 
-	break;
-    case UBX_NAV_TIMEBDS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_TIMEBDS\n");
-	break;
-    case UBX_NAV_TIMEGAL:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_TIMEGAL\n");
-	break;
-    case UBX_NAV_TIMEGLO:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_TIMEGLO\n");
-	break;
-    case UBX_NAV_TIMEGPS:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_NAV_TIMEGPS\n");
-	mask = ubx_msg_nav_timegps(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_TIMELS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_TIMELS\n");
-	break;
-    case UBX_NAV_TIMEUTC:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_TIMEUTC\n");
-	break;
-    case UBX_NAV_VELECEF:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_VELECEF\n");
-	mask = ubx_msg_nav_velecef(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_NAV_VELNED:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_NAV_VELNED\n");
-	break;
+/*
+ * Direct index from (class, id) to ubx_msgs[] entry + 1.  All the
+ * classes we decode are below UBX_CLASS_ESF and all their ids below
+ * 0x80.  It is filled once, under pthread_once(), because reader
+ * threads may parse UBX from several devices at the same time.
+ */
+#define UBX_INDEX_CLASSES	UBX_CLASS_ESF
+#define UBX_INDEX_IDS		0x80
 
-    case UBX_RXM_ALM:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_ALM\n");
-	break;
-    case UBX_RXM_EPH:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_EPH\n");
-	break;
-    case UBX_RXM_IMES:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_IMES\n");
-	break;
-    case UBX_RXM_MEASX:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_RXM_MEASX\n");
-	break;
-    case UBX_RXM_PMREQ:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_PMREQ\n");
-	break;
-    case UBX_RXM_POSREQ:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_POSREQ\n");
-	break;
-    case UBX_RXM_RAW:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_RAW\n");
-	break;
-    case UBX_RXM_RAWX:
-	mask = ubx_rxm_rawx(session, &buf[UBX_PREFIX_LEN], data_len);
-	break;
-    case UBX_RXM_RLM:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_RLM\n");
-	break;
-    case UBX_RXM_RTCM:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_RXM_RTCM\n");
-	break;
-    case UBX_RXM_SFRB:
-	mask = ubx_rxm_sfrb(session, &buf[UBX_PREFIX_LEN]);
-	break;
-    case UBX_RXM_SFRBX:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_RXM_SFRBX\n");
-	break;
-    case UBX_RXM_SVSI:
-	gpsd_log(&session->context->errout, LOG_PROG, "UBX_RXM_SVSI\n");
-	break;
+static unsigned char ubx_index[UBX_INDEX_CLASSES][UBX_INDEX_IDS];
+static pthread_once_t ubx_index_once = PTHREAD_ONCE_INIT;
 
-    case UBX_TIM_DOSC:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_DOSC\n");
-	break;
-    case UBX_TIM_FCHG:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_FCHG\n");
-	break;
-    case UBX_TIM_HOC:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_HOC\n");
-	break;
-    case UBX_TIM_SMEAS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_SMEAS\n");
-	break;
-    case UBX_TIM_SVIN:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_SVIN\n");
-	break;
-    case UBX_TIM_TM:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_TM\n");
-	break;
-    case UBX_TIM_TM2:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_TM2\n");
-	break;
-    case UBX_TIM_TP:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_TP\n");
-	break;
-    case UBX_TIM_TOS:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_TOS\n");
-	break;
-    case UBX_TIM_VCOCAL:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_VCOCAL\n");
-	break;
-    case UBX_TIM_VRFY:
-	gpsd_log(&session->context->errout, LOG_DATA, "UBX_TIM_VRFY\n");
-	break;
+static void ubx_index_build(void)
+{
+    size_t i;
 
-    default:
+    for (i = 0; i < sizeof(ubx_msgs) / sizeof(ubx_msgs[0]); i++) {
+	unsigned int c = ubx_msgs[i].msgid >> 8;
+	unsigned int d = ubx_msgs[i].msgid & 0xff;
+
+	assert(c < UBX_INDEX_CLASSES && d < UBX_INDEX_IDS);
+	ubx_index[c][d] = (unsigned char)(i + 1);
+    }
+}
+
+static const struct ubx_msg_t *ubx_msg_lookup(unsigned short msgid)
+{
+    unsigned int cls = msgid >> 8, id = msgid & 0xff;
+
+    (void)pthread_once(&ubx_index_once, ubx_index_build);
+    if (cls >= UBX_INDEX_CLASSES || id >= UBX_INDEX_IDS
+	|| ubx_index[cls][id] == 0)
+	return NULL;
+    return &ubx_msgs[ubx_index[cls][id] - 1];
+}
+
+gps_mask_t ubx_parse(struct gps_device_t * session,
+		     const unsigned char *buf, size_t len)
+{
+    const struct ubx_msg_t *msg;
+    size_t data_len;
+    unsigned short msgid;
+
+    /* the packet at least contains a head long enough for an empty message */
+    if (len < UBX_PREFIX_LEN)
+	return 0;
+
+    session->cycle_end_reliable = true;
+
+    /* extract message id and length */
+    msgid = (buf[2] << 8) | buf[3];
+    data_len = (size_t) getleu16(buf, 4);
+    if (data_len > len - UBX_PREFIX_LEN) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "UBX: packet id 0x%04hx payload length %zd overruns "
+		 "packet length %zd\n", msgid, data_len, len);
+	return ONLINE_SET;
+    }
+
+    if ((msg = ubx_msg_lookup(msgid)) == NULL) {
 	gpsd_log(&session->context->errout, LOG_WARN,
 		 "UBX: unknown packet id 0x%04hx (length %zd)\n",
 		 msgid, len);
+	return ONLINE_SET;
+    }
+    gpsd_log(&session->context->errout, msg->loglevel, "%s\n", msg->name);
+    if (msg->decode == NULL)
+	return ONLINE_SET;
+    if (data_len < msg->min_len
+	|| (msg->max_len != 0 && data_len > msg->max_len)) {
+	gpsd_log(&session->context->errout, LOG_WARN,
+		 "Invalid %s message, payload len %zd\n",
+		 msg->name, data_len);
+	return ONLINE_SET;
     }
-    return mask | ONLINE_SET;
+    return msg->decode(session, &buf[UBX_PREFIX_LEN], data_len) | ONLINE_SET;
 }
 
 
 static gps_mask_t parse_input(struct gps_device_t *session)
 {
     if (session->lexer.type == UBX_PACKET) {
-	return ubx_parse(session, session->lexer.outbuffer,
+	return ubx_parse(session, session->lexer.frame,
 			 session->lexer.outbuflen);
     } else
 	return generic_parse_input(session);
@@ -1001,12 +1001,12 @@ static const struct gps_type_t driver_rtcm104v2 = {
 
 static gps_mask_t rtcm104v3_analyze(struct gps_device_t *session)
 {
-    uint16_t type = getbeu16(session->lexer.inbuffer, 3) >> 4;
+    uint16_t type = getbeu16(session->lexer.frame, 3) >> 4;
 
     gpsd_log(&session->context->errout, LOG_RAW, "RTCM 3.x packet %d\n", type);
     rtcm3_unpack(session->context,
 		 &session->gpsdata.rtcm3,
-		 (char *)session->lexer.outbuffer);
+		 (const char *)session->lexer.frame);
     session->cycle_end_reliable = true;
     return RTCM3_SET;
 }
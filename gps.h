@@ -41,9 +41,11 @@ extern "C" {
  *       increased length of devconfig_t.subtype
  *       add gnssid:svid:sigid to satellite_t
  *       add mtime to attitude_t
+ * 7.1 - add RAW_SET and rawmeas_t, the raw measurement report,
+ *       to the union; it does not grow gps_data_t.  Add gps_data_copy().
  */
 #define GPSD_API_MAJOR_VERSION	7	/* bump on incompatible changes */
-#define GPSD_API_MINOR_VERSION	0	/* bump on compatible changes */
+#define GPSD_API_MINOR_VERSION	1	/* bump on compatible changes */
 
 #define MAXCHANNELS	120	/* u-blox 9 tracks 140 signals */
 #define MAXUSERDEVS	4	/* max devices per user */
@@ -1917,6 +1919,30 @@ struct rawdata_t {
 #define SAT_FIX_USED	0x40		/* used for position fix */
 };
 
+/*
+ * Compact raw measurement record, one entry per tracked signal.  Only
+ * the first nmeas entries of meas[] are valid; use gps_data_copy() to
+ * copy a gps_data_t holding one without dragging the rest along.
+ */
+struct meas_t {
+    unsigned char gnssid;		/* as in satellite_t */
+    unsigned char svid;
+    unsigned char sigid;
+    unsigned char freqid;		/* GLONASS frequency slot + 7 */
+    unsigned char snr;			/* dBHz */
+    unsigned char satstat;		/* SAT_* tracking status */
+    unsigned short locktime;		/* carrier lock time, ms */
+    double pseudorange;			/* meters */
+    double carrierphase;		/* cycles */
+    double doppler;			/* Hz */
+};
+
+struct rawmeas_t {
+    timestamp_t mtime;			/* measurement time */
+    int nmeas;				/* valid entries in meas[] */
+    struct meas_t meas[MAXCHANNELS];
+};
+
 struct version_t {
     char release[64];			/* external version */
     char rev[64];			/* internal revision ID */
@@ -2041,7 +2067,8 @@ struct gps_data_t {
 #define ECEF_SET	(1llu<<36)
 #define VECEF_SET	(1llu<<37)
 #define MAGNETIC_TRACK_SET (1llu<<38)
-#define SET_HIGH_BIT	39
+#define RAW_SET 	(1llu<<39)
+#define SET_HIGH_BIT	40
     timestamp_t online;		/* NZ if GPS is on line, 0 if not.
 				 *
 				 * Note: gpsd clears this time when sentences
@@ -2091,7 +2118,7 @@ struct gps_data_t {
     } devices;
 
     /* pack things never reported together to reduce structure size */
-#define UNION_SET	(RTCM2_SET|RTCM3_SET|SUBFRAME_SET|AIS_SET|ATTITUDE_SET|GST_SET|OSCILLATOR_SET|VERSION_SET|LOGMESSAGE_SET|ERROR_SET|TOFF_SET|PPS_SET)
+#define UNION_SET	(RTCM2_SET|RTCM3_SET|SUBFRAME_SET|AIS_SET|ATTITUDE_SET|GST_SET|OSCILLATOR_SET|VERSION_SET|LOGMESSAGE_SET|ERROR_SET|TOFF_SET|PPS_SET|RAW_SET)
     union {
 	/* unusual forms of sensor data that might come up the pipe */
 	struct rtcm2_t	rtcm2;
@@ -2101,6 +2128,7 @@ struct gps_data_t {
 	struct attitude_t attitude;
         struct navdata_t navdata;
 	struct rawdata_t raw;
+	struct rawmeas_t rawmeas;
 	struct gst_t gst;
 	struct oscillator_t osc;
 	/* "artificial" structures for various protocol responses */
@@ -2143,6 +2171,7 @@ extern void gps_clear_att(struct attitude_t *);
 extern void gps_clear_dop( struct dop_t *);
 extern void gps_clear_fix(struct gps_fix_t *);
 extern void gps_merge_fix(struct gps_fix_t *, gps_mask_t, struct gps_fix_t *);
+extern void gps_data_copy(struct gps_data_t *, const struct gps_data_t *);
 extern void gps_enable_debug(int, FILE *);
 extern const char *gps_maskdump(gps_mask_t);
 
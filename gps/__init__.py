@@ -13,7 +13,7 @@ from .misc import *
 # Keep in sync with GPSD_PROTO_MAJOR_VERSION and GPSD_PROTO_MINOR_VERSION in
 # gpsd.h
 api_major_version = 3   # bumped on incompatible changes
-api_minor_version = 13  # bumped on compatible changes
+api_minor_version = 15  # bumped on compatible changes
 
 # keep in sync with gpsd_version in SConstruct
 __version__ = '3.18.1'
@@ -9,6 +9,11 @@
 
 #define GPS_JSON_COMMAND_MAX	80
 #define GPS_JSON_RESPONSE_MAX	4096
+#define GPS_JSON_PROTOCOLS_MAX	128	/* DEVICE "protocols" list */
+#define GPS_JSON_RAW_ENTRY_MAX	256	/* one RAW "rawdata" object */
+/* a RAW line with a full tracking list */
+#define GPS_JSON_RAW_MAX	(GPS_JSON_RESPONSE_MAX \
+				 + MAXCHANNELS * GPS_JSON_RAW_ENTRY_MAX)
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +30,7 @@ void json_tpv_dump(const struct gps_device_t *,
 		   const struct gps_policy_t *, char *, size_t);
 void json_noise_dump(const struct gps_data_t *, char *, size_t);
 void json_sky_dump(const struct gps_data_t *, char *, size_t);
+int json_raw_dump(const struct gps_data_t *, char *, size_t);
 void json_att_dump(const struct gps_data_t *, char *, size_t);
 void json_oscillator_dump(const struct gps_data_t *, char *, size_t);
 void json_subframe_dump(const struct gps_data_t *, char buf[], size_t);
@@ -33,7 +39,8 @@ void json_watch_dump(const struct gps_policy_t *, char *, size_t);
 int json_watch_read(const char *, struct gps_policy_t *,
 		    const char **);
 int json_device_read(const char *, struct devconfig_t *,
-		     const char **);
+		     char *, size_t, const char **);
+int json_protocols_read(const char *, unsigned int *);
 void json_version_dump(char *, size_t);
 void json_aivdm_dump(const struct ais_t *, const char *, bool,
 		     char *, size_t);
@@ -12,7 +12,7 @@
 
 const char *gps_maskdump(gps_mask_t set)
 {
-    static char buf[222];
+    static char buf[226];
     const struct {
         gps_mask_t      mask;
         const char      *name;
@@ -55,6 +55,7 @@ const char *gps_maskdump(gps_mask_t set)
         {ECEF_SET,	"ECEF"},
         {VECEF_SET,	"VECEF"},
         {MAGNETIC_TRACK_SET,	"MAGNETIC_TRACK"},
+        {RAW_SET,	"RAW"},
         {RAW_IS,	"RAW"},
         {USED_IS,	"USED"},
         {DRIVER_IS,	"DRIVER"},
@@ -25,6 +25,7 @@
 #include <sys/types.h>
 #include <sys/time.h>		/* for select() */
 #include <sys/select.h>
+#include <sys/uio.h>		/* for writev() */
 #include <stdio.h>
 #include <stdint.h>		/* for uint32_t, etc. */
 #include <time.h>
@@ -66,6 +67,17 @@
 #include "sd_socket.h"
 #endif
 
+#if defined(READER_THREADS_ENABLE) || defined(ACCEPT_THREAD_ENABLE)
+#include <poll.h>
+#endif /* READER_THREADS_ENABLE || ACCEPT_THREAD_ENABLE */
+#ifdef READER_THREADS_ENABLE
+#include <semaphore.h>
+#endif /* READER_THREADS_ENABLE */
+
+#ifdef IO_URING_ENABLE
+#include <linux/io_uring.h>
+#endif /* IO_URING_ENABLE */
+
 /*
  * The name of a tty device from which to pick up whatever the local
  * owning group for tty devices is.  Used when we drop privileges.
@@ -83,8 +95,7 @@
  * that open connections and just sit there, not issuing a WATCH or
  * doing anything else that triggers a device assignment.  Clients
  * in watcher or raw mode that don't read their data will get dropped
- * when throttled_write() fills up the outbound buffers and the
- * NOREAD_TIMEOUT expires.
+ * when their output queue has gone NOREAD_TIMEOUT without draining.
  *
  * RELEASE_TIMEOUT sets the amount of time we hold a device
  * open after the last subscriber closes it; this is nonzero so a
@@ -112,6 +123,24 @@
 
 #define QLEN			5
 
+/*
+ * Output queueing.  Whatever a client's socket won't take at once is
+ * queued, up to CLIENT_QUEUE bytes unless -Q says otherwise, and sent
+ * when the socket becomes writable.  When the queue is full, -O picks
+ * between dropping the oldest queued reports, dropping the oldest
+ * reports other than TPV, and disconnecting the client.
+ */
+#define CLIENT_QUEUE		65536
+
+/*
+ * Main-loop scheduling.  Each pass serves the devices first.  Client
+ * output draining and client commands then get CLIENT_BUDGET
+ * microseconds, or what -B says.  Whatever is left over stays ready
+ * and is picked up on the next pass, after the devices again.  Start
+ * points rotate so the same clients aren't always served last.
+ */
+#define CLIENT_BUDGET		10000
+
 /*
  * If ntpshm is enabled, we renice the process to this priority level.
  * For precise timekeeping increase priority.
@@ -143,12 +172,21 @@ static const int af_allowed = AF_UNSPEC;
 #else
 static const int af_allowed = AF_INET;
 #endif
+
+enum overflow_t {overflow_oldest, overflow_class, overflow_disconnect};
+static size_t client_queue = CLIENT_QUEUE;
+static enum overflow_t overflow_policy = overflow_oldest;
+static long client_budget = CLIENT_BUDGET;
 #endif /* SOCKET_EXPORT_ENABLE */
 
 #define AFCOUNT 2
 
+#ifdef EPOLL_ENABLE
+static int epfd = -1;
+#else
 static fd_set all_fds;
 static int maxfd;
+#endif /* EPOLL_ENABLE */
 static int highwater;
 #ifndef FORCE_GLOBAL_ENABLE
 static bool listen_global = false;
@@ -233,20 +271,24 @@ static void typelist(void)
 
 static void usage(void)
 {
-    (void)printf("usage: gpsd [-b] [-D n] [-F sockfile] [-G] [-h] [-n] [-N] [-P pidfile] [-S port] device...\n\
+    (void)printf("usage: gpsd [-B usec] [-b] [-D n] [-F sockfile] [-G] [-h] [-L] [-n] [-N] [-O policy] [-P pidfile] [-Q bytes] [-S port] device...\n\
   Options include: \n\
+  -B integer (default %d) = client work per loop pass in microseconds\n\
   -b		     	    = bluetooth-safe: open data sources read-only\n\
   -D integer (default 0)    = set debug level \n\
   -F sockfile		    = specify control socket location\n"
 #ifndef FORCE_GLOBAL_ENABLE
 "  -G         		    = make gpsd listen on INADDR_ANY\n"
 #endif /* FORCE_GLOBAL_ENABLE */
-"  -h		     	    = help message \n"
+"  -h		     	    = help message \n\
+  -L			    = keep hunting for every protocol on a device\n"
 #ifndef FORCE_NOWAIT
 "  -n			    = don't wait for client connects to poll GPS\n"
 #endif /* FORCE_NOWAIT */
 "  -N			    = don't go into background\n\
+  -O oldest|class|disconnect = full client queue policy (default oldest)\n\
   -P pidfile	      	    = set file to record process ID\n\
+  -Q integer (default %d) = client output queue size in bytes\n\
   -r               	    = use GPS time even if no fix\n\
   -S integer (default %s) = set port for daemon \n\
   -V			    = emit version and exit.\n"
@@ -261,7 +303,7 @@ in which case it specifies an input source for device, DGPS or ntrip data.\n"
 #endif /* NETFEED_ENABLE */
 "\n\
 The following driver types are compiled into this gpsd instance:\n",
-		 DEFAULT_GPSD_PORT);
+		 CLIENT_BUDGET, CLIENT_QUEUE, DEFAULT_GPSD_PORT);
     typelist();
 }
 
@@ -296,7 +338,7 @@ static socket_t filesock(char *filename)
 }
 #endif /* CONTROL_SOCKET_ENABLE */
 
-#define sub_index(s) (int)((s) - subscribers)
+#define sub_index(s) ((s)->index)
 #define allocated_device(devp)	 ((devp)->gpsdata.dev.path[0] != '\0')
 #define free_device(devp)	 (devp)->gpsdata.dev.path[0] = '\0'
 #define initialized_device(devp) ((devp)->context != NULL)
@@ -307,6 +349,80 @@ static socket_t filesock(char *filename)
  */
 static struct gps_device_t devices[MAX_DEVICES];
 
+/*
+ * Main-loop event backend.
+ *
+ * Every descriptor the daemon waits on is registered together with
+ * the kind of object that owns it and that object's slot number, so a
+ * wakeup can be dispatched straight to its device or subscriber
+ * instead of testing every slot against the ready set.  With epoll(7)
+ * the owner travels in the event itself and there is no FD_SETSIZE
+ * ceiling; the pselect(2) fallback keeps an owner table indexed by fd.
+ */
+enum fd_owner_t {
+    owner_none,
+    owner_listener,		/* client listening socket, index into msocks */
+    owner_control_listener,	/* control listening socket */
+    owner_control,		/* control-socket connection */
+    owner_device,		/* index into devices[] */
+    owner_client,		/* index into client_pool[] */
+    owner_wakeup,		/* main-loop wakeup pipe */
+    owner_acceptor,		/* accept-thread wakeup pipe */
+};
+
+struct fd_event_t {
+    enum fd_owner_t owner;
+    int index;
+    int fd;
+    bool readable;		/* input, EOF or error pending */
+    bool writable;		/* room to send queued output */
+};
+
+/*
+ * Other threads write a byte here to get the main loop out of its
+ * wait: reader threads after a hand-off, and, in the pselect build,
+ * whoever queues client output (epoll notices a changed interest
+ * set by itself, pselect does not).
+ */
+static int wake_pipe[2] = {-1, -1};
+
+static int open_wake_pipe(int fds[2])
+/* make a non-blocking, close-on-exec pipe for waking a thread */
+{
+    int i;
+
+    /* pipe2() would do this in one call, but it isn't POSIX */
+    if (pipe(fds) == -1)
+	return -1;
+    for (i = 0; i < 2; i++) {
+	(void)fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+	(void)fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    return 0;
+}
+
+#ifdef EPOLL_ENABLE
+#define MAX_EVENTS	128
+
+/* pack owner, slot and descriptor into the epoll user data */
+#define EVENT_KEY(owner, index, fd)	(((uint64_t)(owner) << 56) \
+					 | ((uint64_t)(index) << 32) \
+					 | (uint32_t)(fd))
+#define EVENT_OWNER(key)	((enum fd_owner_t)((key) >> 56))
+#define EVENT_INDEX(key)	((int)(((key) >> 32) & 0xffffff))
+#define EVENT_FD(key)		((int)((key) & 0xffffffff))
+#else
+#define MAX_EVENTS	FD_SETSIZE
+
+static struct {
+    enum fd_owner_t owner;
+    int index;
+} fd_owners[FD_SETSIZE];
+
+/* descriptors with queued output; the PPS thread may queue too */
+static fd_set out_fds;
+static pthread_mutex_t out_fds_lock = PTHREAD_MUTEX_INITIALIZER;
+
 static void adjust_max_fd(int fd, bool on)
 /* track the largest fd currently in use */
 {
@@ -324,6 +440,133 @@ static void adjust_max_fd(int fd, bool on)
 	}
     }
 }
+#endif /* EPOLL_ENABLE */
+
+static bool watch_fd(int fd, enum fd_owner_t owner, int index)
+/* start waiting for input on a descriptor on behalf of its owner */
+{
+#ifdef EPOLL_ENABLE
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = EVENT_KEY(owner, index, fd);
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) == 0)
+	return true;
+    /* already watched, e.g. a device flagged ready twice */
+    if (errno == EEXIST && epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) == 0)
+	return true;
+    gpsd_log(&context.errout, LOG_ERROR,
+	     "epoll_ctl(%d): %s\n", fd, strerror(errno));
+    return false;
+#else
+    if (fd < 0 || fd >= (int)FD_SETSIZE) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "descriptor %d exceeds FD_SETSIZE\n", fd);
+	return false;
+    }
+    fd_owners[fd].owner = owner;
+    fd_owners[fd].index = index;
+    FD_SET(fd, &all_fds);
+    adjust_max_fd(fd, true);
+    return true;
+#endif /* EPOLL_ENABLE */
+}
+
+static void watch_output(int fd, enum fd_owner_t owner, int index, bool on)
+/* start or stop waiting for a watched descriptor to become writable */
+{
+#ifdef EPOLL_ENABLE
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | (on ? EPOLLOUT : 0);
+    ev.data.u64 = EVENT_KEY(owner, index, fd);
+    if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev) != 0)
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "epoll_ctl(%d): %s\n", fd, strerror(errno));
+#else
+    (void)owner;	/* pselect keeps these in fd_owners already */
+    (void)index;
+    if (fd < 0 || fd >= (int)FD_SETSIZE)
+	return;
+    (void)pthread_mutex_lock(&out_fds_lock);
+    if (on)
+	FD_SET(fd, &out_fds);
+    else
+	FD_CLR(fd, &out_fds);
+    (void)pthread_mutex_unlock(&out_fds_lock);
+    /* the PPS thread may queue while we sit in pselect() */
+    if (on)
+	ignore_return(write(wake_pipe[1], "", 1));
+#endif /* EPOLL_ENABLE */
+}
+
+static void unwatch_fd(int fd)
+/* stop waiting for input on a descriptor; call before closing it */
+{
+#ifdef EPOLL_ENABLE
+    /* ENOENT and EBADF are fine, close(2) already dropped it */
+    (void)epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+#else
+    if (fd < 0 || fd >= (int)FD_SETSIZE)
+	return;
+    fd_owners[fd].owner = owner_none;
+    FD_CLR(fd, &all_fds);
+    watch_output(fd, owner_none, 0, false);
+    adjust_max_fd(fd, false);
+#endif /* EPOLL_ENABLE */
+}
+
+static int await_events(struct fd_event_t *events, int *nevents)
+/* wait for input, return an AWAIT_* status and the owners of ready fds */
+{
+    int i, status;
+#ifdef EPOLL_ENABLE
+    struct epoll_event ready[MAX_EVENTS];
+    int nready;
+
+    status = gpsd_await_events(epfd, ready, NITEMS(ready), &nready,
+			       &context.errout);
+    for (i = 0; i < nready; i++) {
+	events[i].owner = EVENT_OWNER(ready[i].data.u64);
+	events[i].index = EVENT_INDEX(ready[i].data.u64);
+	events[i].fd = EVENT_FD(ready[i].data.u64);
+	/* errors and hangups surface through the read side */
+	events[i].readable = (ready[i].events & ~EPOLLOUT) != 0;
+	events[i].writable = (ready[i].events & EPOLLOUT) != 0;
+    }
+    *nevents = nready;
+#else
+    fd_set rfds, wfds, efds, want_out;
+    int fd;
+
+    (void)pthread_mutex_lock(&out_fds_lock);
+    want_out = out_fds;
+    (void)pthread_mutex_unlock(&out_fds_lock);
+    status = gpsd_await_io(&rfds, &wfds, &efds, maxfd,
+			   &all_fds, &want_out, &context.errout);
+    /* on AWAIT_NOT_READY, report the descriptors that went bad instead */
+    if (status != AWAIT_GOT_INPUT) {
+	rfds = efds;
+	FD_ZERO(&wfds);
+    }
+    *nevents = 0;
+    for (fd = 0; fd <= maxfd; fd++)
+	if (FD_ISSET(fd, &rfds) || FD_ISSET(fd, &wfds)) {
+	    events[*nevents].owner = fd_owners[fd].owner;
+	    events[*nevents].index = fd_owners[fd].index;
+	    events[*nevents].fd = fd;
+	    events[*nevents].readable = FD_ISSET(fd, &rfds);
+	    events[*nevents].writable = FD_ISSET(fd, &wfds);
+	    ++*nevents;
+	}
+    if (status == AWAIT_NOT_READY)
+	for (i = 0; i < *nevents; i++)
+	    fd_owners[events[i].fd].owner = owner_none;
+#endif /* EPOLL_ENABLE */
+    return status;
+}
 
 #ifdef SOCKET_EXPORT_ENABLE
 #ifndef IPTOS_LOWDELAY
@@ -516,17 +759,67 @@ static int passivesocks(char *service, char *tcp_or_udp,
 }
 /* *INDENT-ON* */
 
+struct outmsg_t
+{
+    char *buf;
+    size_t len;
+    bool tpv;			  /* a TPV report, kept under overflow_class */
+};
+
 struct subscriber_t
 {
     int fd;			  /* client file descriptor. -1 if unused */
     time_t active;		  /* when subscriber last polled for data */
     struct gps_policy_t policy;	  /* configurable bits */
     pthread_mutex_t mutex;	  /* serialize access to fd */
+    int index;			  /* permanent slot in client_pool */
+    int position;		  /* offset in active_clients, -1 if free */
+    int watching[MAX_DEVICES];	  /* offset in device_watchers, -1 if not */
+    struct outmsg_t *outq;	  /* ring of output waiting for the socket */
+    int outq_head;		  /* ring index of the oldest message */
+    int outq_count;		  /* messages queued */
+    int outq_slots;		  /* ring capacity */
+    size_t outq_sent;		  /* bytes of the oldest already sent */
+    size_t outq_bytes;		  /* bytes queued, including outq_sent */
+    time_t outq_moved;		  /* when the queue last made progress */
 };
 
+#define OUTQ_AT(sub, n)	(&(sub)->outq[((sub)->outq_head + (n)) % (sub)->outq_slots])
+
 #define subscribed(sub, devp)    (sub->policy.watcher && (sub->policy.devpath[0]=='\0' || strcmp(sub->policy.devpath, devp->gpsdata.dev.path)==0))
 
-static struct subscriber_t subscribers[MAX_CLIENTS];	/* indexed by client file descriptor */
+/*
+ * The client table.  Subscriber structures are allocated on demand
+ * and never freed, so pointers to them stay valid for the life of the
+ * daemon; client_pool maps a slot number back to its structure.  The
+ * allocated subscribers are also kept in the dense active_clients
+ * list, so that fan-out costs scale with the number of connected
+ * clients rather than the size of the table.  MAX_CLIENTS is only the
+ * initial size; the table doubles whenever it fills.
+ *
+ * The PPS thread fans out through notify_watchers(), so changes to
+ * either list and walks over active_clients hold client_lock.  It is
+ * recursive because a failed write detaches its client mid-walk.
+ * Walks go from the end of the list down, so the swap-with-last
+ * removal in detach_client() never skips an entry.
+ */
+static struct subscriber_t **client_pool;
+static int pool_size;
+static struct subscriber_t **active_clients;
+static int nclients;
+static int *free_slots;
+static int nfree;
+static pthread_mutex_t client_lock;
+
+static void lock_clients(void)
+{
+    (void)pthread_mutex_lock(&client_lock);
+}
+
+static void unlock_clients(void)
+{
+    (void)pthread_mutex_unlock(&client_lock);
+}
 
 static void lock_subscriber(struct subscriber_t *sub)
 {
@@ -538,33 +831,288 @@ static void unlock_subscriber(struct subscriber_t *sub)
     (void)pthread_mutex_unlock(&sub->mutex);
 }
 
+static bool grow_clients(void)
+/* double the client table, or create it at MAX_CLIENTS slots */
+{
+    int newsize = (pool_size == 0) ? MAX_CLIENTS : pool_size * 2;
+    struct subscriber_t **newpool, **newactive;
+    int *newfree;
+    int si, di;
+
+    newpool = realloc(client_pool, newsize * sizeof(*newpool));
+    if (newpool == NULL)
+	return false;
+    client_pool = newpool;
+    newactive = realloc(active_clients, newsize * sizeof(*newactive));
+    if (newactive == NULL)
+	return false;
+    active_clients = newactive;
+    newfree = realloc(free_slots, newsize * sizeof(*newfree));
+    if (newfree == NULL)
+	return false;
+    free_slots = newfree;
+
+    for (si = pool_size; si < newsize; si++) {
+	struct subscriber_t *sub = calloc(1, sizeof(*sub));
+	if (sub == NULL) {
+	    /* undo the partial grow; nothing went on the free list yet */
+	    while (--si >= pool_size) {
+		(void)pthread_mutex_destroy(&client_pool[si]->mutex);
+		free(client_pool[si]);
+		client_pool[si] = NULL;
+	    }
+	    return false;
+	}
+	sub->fd = UNALLOCATED_FD;
+	sub->index = si;
+	sub->position = -1;
+	for (di = 0; di < MAX_DEVICES; di++)
+	    sub->watching[di] = -1;
+	(void)pthread_mutex_init(&sub->mutex, NULL);
+	client_pool[si] = sub;
+    }
+    /* every new slot exists; push them so the lowest is handed out first */
+    for (si = newsize - 1; si >= pool_size; si--)
+	free_slots[nfree++] = si;
+    gpsd_log(&context.errout, LOG_INF,
+	     "client table grown from %d to %d slots\n", pool_size, newsize);
+    pool_size = newsize;
+    return true;
+}
+
 static struct subscriber_t *allocate_client(void)
 /* return the address of a subscriber structure allocated for a new session */
 {
-    int si;
+    struct subscriber_t *sub;
 
 #if UNALLOCATED_FD == 0
 #error client allocation code will fail horribly
 #endif
-    for (si = 0; si < NITEMS(subscribers); si++) {
-	if (subscribers[si].fd == UNALLOCATED_FD) {
-	    subscribers[si].fd = 0;	/* mark subscriber as allocated */
-	    return &subscribers[si];
+    lock_clients();
+    /*
+     * A failed grow leaves the table as it was (the arrays may have
+     * been enlarged, but no new slot is visible), so just give up.
+     */
+    if (nfree == 0 && !grow_clients()) {
+	unlock_clients();
+	return NULL;
+    }
+    sub = client_pool[free_slots[--nfree]];
+    sub->fd = 0;	/* mark subscriber as allocated */
+    sub->position = nclients;
+    active_clients[nclients++] = sub;
+    unlock_clients();
+    return sub;
+}
+
+/*
+ * Per-device subscriber index.  device_watchers[n] lists the clients
+ * for which subscribed() holds against devices[n], so a report goes
+ * straight to its watchers instead of testing every client.  A
+ * client's entries are recomputed whenever its ?WATCH policy changes
+ * or it detaches, and a device slot's list is rebuilt when a new
+ * device is stashed there.  A slot's list may go stale between the
+ * device being freed and the slot being reused, so fan-out still
+ * checks subscribed() on each entry.  Changes hold client_lock.
+ */
+struct watcher_list_t
+{
+    struct subscriber_t **subs;
+    int count;
+    int size;
+};
+static struct watcher_list_t device_watchers[MAX_DEVICES];
+
+static void index_watcher(struct subscriber_t *sub, int di, bool watching)
+/* add a client to, or drop it from, one device's watcher list */
+{
+    struct watcher_list_t *wl = &device_watchers[di];
+
+    if (watching && sub->watching[di] == -1) {
+	if (wl->count == wl->size) {
+	    int newsize = (wl->size == 0) ? 8 : wl->size * 2;
+	    struct subscriber_t **newsubs =
+		realloc(wl->subs, newsize * sizeof(*newsubs));
+	    if (newsubs == NULL) {
+		gpsd_log(&context.errout, LOG_ERROR,
+			 "can't grow watcher list of device %d\n", di);
+		return;
+	    }
+	    wl->subs = newsubs;
+	    wl->size = newsize;
 	}
+	sub->watching[di] = wl->count;
+	wl->subs[wl->count++] = sub;
+    } else if (!watching && sub->watching[di] != -1) {
+	struct subscriber_t *last = wl->subs[--wl->count];
+	wl->subs[sub->watching[di]] = last;
+	last->watching[di] = sub->watching[di];
+	sub->watching[di] = -1;
     }
-    return NULL;
+}
+
+static void reindex_client(struct subscriber_t *sub)
+/* recompute which device watcher lists a client belongs to */
+{
+    int di;
+
+    lock_clients();
+    for (di = 0; di < MAX_DEVICES; di++)
+	index_watcher(sub, di,
+		      sub->fd != UNALLOCATED_FD
+		      && allocated_device(&devices[di])
+		      && subscribed(sub, (&devices[di])));
+    unlock_clients();
+}
+
+static void reindex_device(struct gps_device_t *device)
+/* rebuild the watcher list of a newly stashed device */
+{
+    int ci, di = (int)(device - devices);
+
+    lock_clients();
+    for (ci = 0; ci < nclients; ci++)
+	index_watcher(active_clients[ci], di,
+		      active_clients[ci]->fd != UNALLOCATED_FD
+		      && subscribed(active_clients[ci], device));
+    unlock_clients();
+}
+
+static void free_client(struct subscriber_t *sub)
+/* return a subscriber slot to the free list; caller holds client_lock */
+{
+    struct subscriber_t *last;
+
+    sub->fd = UNALLOCATED_FD;
+    /* move the last active client into the hole */
+    last = active_clients[--nclients];
+    active_clients[sub->position] = last;
+    last->position = sub->position;
+    sub->position = -1;
+    free_slots[nfree++] = sub->index;
+}
+
+static void outq_drop(struct subscriber_t *sub, int n)
+/* remove the n'th queued message; caller holds the subscriber lock */
+{
+    int i;
+
+    sub->outq_bytes -= OUTQ_AT(sub, n)->len;
+    free(OUTQ_AT(sub, n)->buf);
+    if (n == 0)
+	sub->outq_head = (sub->outq_head + 1) % sub->outq_slots;
+    else
+	for (i = n; i < sub->outq_count - 1; i++)
+	    *OUTQ_AT(sub, i) = *OUTQ_AT(sub, i + 1);
+    --sub->outq_count;
+}
+
+static void outq_clear(struct subscriber_t *sub)
+/* discard everything queued for a client */
+{
+    while (sub->outq_count > 0)
+	outq_drop(sub, 0);
+    sub->outq_head = 0;
+    sub->outq_sent = 0;
+    sub->outq_bytes = 0;
+}
+
+static bool outq_push(struct subscriber_t *sub,
+		      const char *buf, size_t len, size_t sent)
+/*
+ * Queue a message of which sent bytes already went out, making room
+ * as the overflow policy says.  Return false if the client has to be
+ * disconnected.  Caller holds the subscriber lock.
+ */
+{
+    static const char tpvhead[] = "{\"class\":\"TPV\"";
+    bool tpv = len >= sizeof(tpvhead) - 1
+	&& memcmp(buf, tpvhead, sizeof(tpvhead) - 1) == 0;
+    struct outmsg_t *msg;
+
+    /* a half-sent message must go out whole, whatever the bound */
+    while (sent == 0 && sub->outq_bytes - sub->outq_sent + len > client_queue) {
+	/* never drop the head once part of it is on the wire */
+	int n, first = (sub->outq_sent > 0) ? 1 : 0, victim = -1;
+
+	if (overflow_policy == overflow_disconnect) {
+	    gpsd_log(&context.errout, LOG_WARN,
+		     "client(%d) output queue full, disconnecting\n",
+		     sub_index(sub));
+	    return false;
+	}
+	if (overflow_policy == overflow_class) {
+	    for (n = first; n < sub->outq_count; n++)
+		if (!OUTQ_AT(sub, n)->tpv) {
+		    victim = n;
+		    break;
+		}
+	    /* nothing but fixes queued, so the newcomer is worth least */
+	    if (victim == -1 && !tpv)
+		first = sub->outq_count;
+	}
+	if (victim == -1 && first < sub->outq_count)
+	    victim = first;
+	if (victim == -1) {
+	    gpsd_log(&context.errout, LOG_PROG,
+		     "client(%d) output queue full, dropping %zu bytes\n",
+		     sub_index(sub), len);
+	    return true;
+	}
+	gpsd_log(&context.errout, LOG_PROG,
+		 "client(%d) output queue full, dropping %zu queued bytes\n",
+		 sub_index(sub), OUTQ_AT(sub, victim)->len);
+	outq_drop(sub, victim);
+    }
+
+    if (sub->outq_count == sub->outq_slots) {
+	int n, newslots = (sub->outq_slots == 0) ? 16 : sub->outq_slots * 2;
+	struct outmsg_t *newq = calloc(newslots, sizeof(*newq));
+
+	if (newq == NULL)
+	    return false;
+	for (n = 0; n < sub->outq_count; n++)
+	    newq[n] = *OUTQ_AT(sub, n);
+	free(sub->outq);
+	sub->outq = newq;
+	sub->outq_head = 0;
+	sub->outq_slots = newslots;
+    }
+    msg = OUTQ_AT(sub, sub->outq_count);
+    if ((msg->buf = malloc(len)) == NULL)
+	return false;
+    memcpy(msg->buf, buf, len);
+    msg->len = len;
+    msg->tpv = tpv;
+    if (sub->outq_count++ == 0) {
+	sub->outq_sent = sent;
+	sub->outq_moved = time(NULL);
+	watch_output(sub->fd, owner_client, sub_index(sub), true);
+    }
+    sub->outq_bytes += len;
+    return true;
 }
 
 static void detach_client(struct subscriber_t *sub)
 /* detach a client and terminate the session */
 {
     char *c_ip;
+
+    lock_clients();
     lock_subscriber(sub);
     if (sub->fd == UNALLOCATED_FD) {
 	unlock_subscriber(sub);
+	unlock_clients();
 	return;
     }
     c_ip = netlib_sock2ip(sub->fd);
+    unwatch_fd(sub->fd);
+    if (sub->outq_count > 0) {
+	/* it isn't reading, so don't let close(2) linger on it */
+	static struct linger nolinger = { 0, 0 };
+	(void)setsockopt(sub->fd, SOL_SOCKET, SO_LINGER,
+			 (char *)&nolinger, (int)sizeof(nolinger));
+    }
     (void)shutdown(sub->fd, SHUT_RDWR);
     gpsd_log(&context.errout, LOG_SPIN,
 	     "close(%d) in detach_client()\n",
@@ -573,8 +1121,6 @@ static void detach_client(struct subscriber_t *sub)
     gpsd_log(&context.errout, LOG_INF,
 	     "detaching %s (sub %d, fd %d) in detach_client\n",
 	     c_ip, sub_index(sub), sub->fd);
-    FD_CLR(sub->fd, &all_fds);
-    adjust_max_fd(sub->fd, false);
     sub->active = 0;
     sub->policy.watcher = false;
     sub->policy.json = false;
@@ -584,23 +1130,25 @@ static void detach_client(struct subscriber_t *sub)
     sub->policy.timing = false;
     sub->policy.split24 = false;
     sub->policy.devpath[0] = '\0';
-    sub->fd = UNALLOCATED_FD;
+    outq_clear(sub);
     unlock_subscriber(sub);
+    reindex_client(sub);
+    free_client(sub);
+    unlock_clients();
 }
 
-static ssize_t throttled_write(struct subscriber_t *sub, char *buf,
-			       size_t len)
-/* write to client -- throttle if it's gone or we're close to buffer overrun */
+static void log_client_write(struct subscriber_t *sub,
+			     const char *buf, size_t len)
+/* log output to a client */
 {
-    ssize_t status;
-
     if (context.errout.debug >= LOG_CLIENT) {
 	if (isprint((unsigned char) buf[0]))
 	    gpsd_log(&context.errout, LOG_CLIENT,
 		     "=> client(%d): %s\n", sub_index(sub), buf);
 	else {
 #ifndef __clang_analyzer__
-	    char *cp, buf2[MAX_PACKET_LENGTH * 3];
+	    const char *cp;
+	    char buf2[MAX_PACKET_LENGTH * 3];
 	    buf2[0] = '\0';
 	    for (cp = buf; cp < buf + len; cp++)
 		str_appendf(buf2, sizeof(buf2),
@@ -610,60 +1158,699 @@ static ssize_t throttled_write(struct subscriber_t *sub, char *buf,
 #endif /* __clang_analyzer__ */
 	}
     }
+}
+
+static bool queue_unsent(struct subscriber_t *sub,
+			 const struct iovec *iov, int iovcnt, size_t skip)
+/*
+ * Queue what is left of a write after its first skip bytes went out.
+ * Return false if the client has to be disconnected.  Caller holds
+ * the subscriber lock.
+ */
+{
+    int i;
+
+    for (i = 0; i < iovcnt; i++) {
+	if (skip >= iov[i].iov_len) {
+	    skip -= iov[i].iov_len;
+	    continue;
+	}
+	if (!outq_push(sub, iov[i].iov_base, iov[i].iov_len, skip))
+	    return false;
+	skip = 0;
+    }
+    return true;
+}
+
+static void write_failed(struct subscriber_t *sub, int err)
+/* a write to the client failed with err, give up on it */
+{
+    if (err == EBADF)
+	gpsd_log(&context.errout, LOG_WARN,
+		 "client(%d) has vanished.\n", sub_index(sub));
+    else
+	gpsd_log(&context.errout, LOG_INF,
+		 "client(%d) write: %s\n",
+		 sub_index(sub), strerror(err));
+    detach_client(sub);
+}
+
+static ssize_t gathered_write(struct subscriber_t *sub,
+			      const struct iovec *iov, int iovcnt)
+/* write to client -- queue whatever the socket won't take right now */
+{
+    ssize_t status;
+    size_t len = 0;
+    int i;
 
+    for (i = 0; i < iovcnt; i++)
+	len += iov[i].iov_len;
+
+    lock_subscriber(sub);
+    /* anything already queued has to go out first */
+    if (sub->outq_count > 0)
+	status = 0;
+    else {
+#if defined(PPS_ENABLE)
+	gpsd_acquire_reporting_lock();
+#endif /* PPS_ENABLE */
+	if (iovcnt == 1)
+	    status = send(sub->fd, iov[0].iov_base, iov[0].iov_len, 0);
+	else
+	    status = writev(sub->fd, iov, iovcnt);
+#if defined(PPS_ENABLE)
+	gpsd_release_reporting_lock();
+#endif /* PPS_ENABLE */
+	if (status == (ssize_t) len) {
+	    unlock_subscriber(sub);
+	    return status;
+	}
+	if (status == -1 && (errno == EAGAIN || errno == EWOULDBLOCK
+			     || errno == EINTR))
+	    status = 0;		/* no data written, and errno says to retry */
+    }
+    if (status > -1) {
+	/* short or refused write, keep the rest for when it drains */
+	bool queued = queue_unsent(sub, iov, iovcnt, (size_t)status);
+
+	unlock_subscriber(sub);
+	if (!queued)
+	    detach_client(sub);
+	return status;
+    }
+    unlock_subscriber(sub);
+    write_failed(sub, errno);
+    return status;
+}
+
+static ssize_t throttled_write(struct subscriber_t *sub, char *buf,
+			       size_t len)
+/* write to client -- throttle if it's gone or we're close to buffer overrun */
+{
+    struct iovec iov;
+
+    log_client_write(sub, buf, len);
+    iov.iov_base = buf;
+    iov.iov_len = len;
+    return gathered_write(sub, &iov, 1);
+}
+
+/*
+ * Output batching for all_reports().  Everything one packet produces
+ * for a client (raw data, pseudo-NMEA, JSON) is collected here and
+ * goes out in one writev(2), rather than one send(2) per object.
+ * Parts that point into storage which outlives the cycle, such as the
+ * lexer output buffer or the encode cache, are referenced in place;
+ * anything built on the stack is copied into the arena.  The batch is
+ * flushed when output for another client starts, when it fills, and
+ * at the end of the cycle.  Only the main thread batches.
+ */
+#define BATCH_MAX	16
+
+struct batch_part_t {
+    const char *buf;		/* NULL if the part is in the arena */
+    size_t off;
+    size_t len;
+};
+
+static struct {
+    struct subscriber_t *sub;
+    int count;
+    struct batch_part_t part[BATCH_MAX];
+    char *arena;
+    size_t used;
+    size_t size;
+} batch;
+
+static void batch_resolve(struct iovec *iov,
+			  const struct batch_part_t *part, int count)
+/* point iovecs at batch parts; arena parts only hold until it grows */
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+	if (part[i].buf == NULL)
+	    iov[i].iov_base = batch.arena + part[i].off;
+	else
+	    iov[i].iov_base = (char *)part[i].buf;
+	iov[i].iov_len = part[i].len;
+    }
+}
+
+#ifdef IO_URING_ENABLE
+/*
+ * With io_uring, flushed batches are not written one by one but
+ * staged as sendmsg requests, and all of a cycle's batches go to the
+ * kernel in one io_uring_enter(2) when all_reports() is done.  The
+ * arena is kept until then, since staged parts still point into it.
+ * Results are settled just as gathered_write() would: a short or
+ * refused send queues the rest, anything else drops the client.
+ *
+ * A staged send must never overtake output that is already queued for
+ * its client, nor race another send to the same client, or the bytes
+ * of two writes could interleave.  So a client gets at most one staged
+ * send per submission, the queue is checked again under the subscriber
+ * lock when the send goes to the kernel (a batch for a client with
+ * pending output is queued behind it instead), and client_lock is held
+ * until the results are settled, which keeps the PPS thread from
+ * writing to anyone in the meantime.
+ */
+#define URING_ENTRIES	64
+
+static bool uring_active = false;
+
+static struct uring_send_t {
+    struct subscriber_t *sub;
+    int fd;
+    int count;
+    struct batch_part_t part[BATCH_MAX];
+    struct iovec iov[BATCH_MAX];
+    struct msghdr msg;
+    size_t len;
+    ssize_t result;
+} uring_sends[URING_ENTRIES];
+static int nsends;
+
+static void uring_fallback(const char *why)
+/* the ring misbehaved, go back to plain I/O for good */
+{
+    gpsd_log(&context.errout, LOG_WARN,
+	     "io_uring %s: %s, using plain I/O\n", why, strerror(errno));
+    uring_wrap();
+    uring_active = false;
+}
+
+static void uring_send_all(void)
+/* submit the staged batches and settle their results */
+{
+    struct io_uring_cqe cqe;
+    int i, submitted, staged = 0, reaped = 0;
+
+    if (nsends == 0)
+	return;
+    lock_clients();
+    for (i = 0; i < nsends; i++) {
+	struct uring_send_t *send = &uring_sends[i];
+	struct subscriber_t *sub = send->sub;
+	struct io_uring_sqe *sqe;
+	bool queued = true;
+	int j;
+
+	batch_resolve(send->iov, send->part, send->count);
+	send->len = 0;
+	for (j = 0; j < send->count; j++)
+	    send->len += send->iov[j].iov_len;
+	memset(&send->msg, 0, sizeof(send->msg));
+	send->msg.msg_iov = send->iov;
+	send->msg.msg_iovlen = (size_t)send->count;
+	send->result = -ECANCELED;
+
+	lock_subscriber(sub);
+	if (sub->fd != send->fd)
+	    send->result = (ssize_t)send->len;	/* dropped since staging */
+	else if (sub->outq_count > 0) {
+	    /* output went pending since staging, this goes behind it */
+	    queued = queue_unsent(sub, send->iov, send->count, 0);
+	    send->result = (ssize_t)send->len;	/* settled */
+	}
+	unlock_subscriber(sub);
+	if (!queued)
+	    detach_client(sub);
+	if (send->result != -ECANCELED)
+	    continue;
+	if ((sqe = uring_get_sqe()) == NULL)
+	    continue;
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = send->fd;
+	sqe->addr = (uint64_t)(uintptr_t)&send->msg;
+	sqe->len = 1;
+	sqe->msg_flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+	sqe->user_data = (uint64_t)i;
+	staged++;
+    }
 #if defined(PPS_ENABLE)
     gpsd_acquire_reporting_lock();
 #endif /* PPS_ENABLE */
-    status = send(sub->fd, buf, len, 0);
+    submitted = uring_submit((unsigned)staged);
+    while (reaped < submitted) {
+	if (!uring_reap(&cqe)) {
+	    if (uring_submit(1) == -1)
+		break;
+	    continue;
+	}
+	uring_sends[cqe.user_data].result = cqe.res;
+	reaped++;
+    }
 #if defined(PPS_ENABLE)
     gpsd_release_reporting_lock();
+#endif /* PPS_ENABLE */
+    if (submitted == -1 || reaped < submitted)
+	uring_fallback("send failed");
+
+    for (i = 0; i < nsends; i++) {
+	struct uring_send_t *send = &uring_sends[i];
+	struct subscriber_t *sub = send->sub;
+	ssize_t status = send->result;
+	bool queued;
+
+	/* dropped while the cycle was being reported */
+	if (sub->fd != send->fd || status == (ssize_t)send->len)
+	    continue;
+	if (status == -EAGAIN || status == -EWOULDBLOCK
+	    || status == -EINTR || status == -ECANCELED)
+	    status = 0;		/* nothing went out, keep it all */
+	if (status < 0) {
+	    write_failed(sub, (int)-status);
+	    continue;
+	}
+	lock_subscriber(sub);
+	queued = queue_unsent(sub, send->iov, send->count, (size_t)status);
+	unlock_subscriber(sub);
+	if (!queued)
+	    detach_client(sub);
+    }
+    nsends = 0;
+    unlock_clients();
+}
+
+static bool uring_stage(struct subscriber_t *sub, int count)
+/* stage the flushed batch; false if it has to go the plain way */
+{
+    struct uring_send_t *send;
+    int i;
+
+    /* a second batch for a client must not race the first */
+    for (i = 0; i < nsends; i++)
+	if (uring_sends[i].sub == sub)
+	    break;
+    if (nsends == URING_ENTRIES || i < nsends)
+	uring_send_all();
+    /* gathered_write() puts it behind what is already queued */
+    if (!uring_active || sub->outq_count > 0)
+	return false;
+    send = &uring_sends[nsends++];
+    send->sub = sub;
+    send->fd = sub->fd;
+    send->count = count;
+    memcpy(send->part, batch.part, count * sizeof(batch.part[0]));
+    return true;
+}
+
+#ifndef READER_THREADS_ENABLE
+static bool uring_reads = false;
+
+static void uring_prefetch(const bool *ready)
+/* read every ready device into its registered lexer buffer at once */
+{
+    struct gps_device_t *device;
+    struct io_uring_cqe cqe;
+    int submitted, reaped = 0;
+    unsigned count = 0;
+
+    for (device = devices; device < devices + MAX_DEVICES; device++) {
+	struct gps_lexer_t *lexer = &device->lexer;
+	struct io_uring_sqe *sqe;
+	size_t room;
+
+	/* only devices whose packets come through packet_get() */
+	if (!ready[device - devices] || !allocated_device(device)
+	    || device->gpsdata.gps_fd <= 0
+	    || device->servicetype != service_sensor
+	    || (device->device_type != NULL
+		&& device->device_type->get_packet != generic_get)
+	    || lexer->prefetched > 0
+	    || (room = packet_space(lexer)) == 0)
+	    continue;
+	if ((sqe = uring_get_sqe()) == NULL)
+	    break;
+	sqe->opcode = IORING_OP_READ_FIXED;
+	sqe->fd = device->gpsdata.gps_fd;
+	sqe->addr = (uint64_t)(uintptr_t)(lexer->inbuffer + lexer->inbuflen);
+	sqe->len = (unsigned)room;
+	sqe->buf_index = (uint16_t)(device - devices);
+	sqe->user_data = (uint64_t)(device - devices);
+	count++;
+    }
+    if (count == 0)
+	return;
+    submitted = uring_submit(count);
+    while (reaped < submitted) {
+	if (!uring_reap(&cqe)) {
+	    if (uring_submit(1) == -1)
+		break;
+	    continue;
+	}
+	/* errors and EOF are left for packet_get() to rediscover */
+	if (cqe.res > 0)
+	    devices[cqe.user_data].lexer.prefetched = (size_t)cqe.res;
+	reaped++;
+    }
+    if (submitted == -1 || reaped < submitted) {
+	uring_fallback("read failed");
+	uring_reads = false;
+    }
+}
+#endif /* READER_THREADS_ENABLE */
+#endif /* IO_URING_ENABLE */
+
+static void batch_flush(void)
+/* ship the pending batch to its client */
+{
+    struct iovec iov[BATCH_MAX];
+    struct subscriber_t *sub = batch.sub;
+    int count = batch.count;
+
+    batch.sub = NULL;
+    batch.count = 0;
+    if (sub == NULL || count == 0)
+	return;
+#ifdef IO_URING_ENABLE
+    if (uring_active && uring_stage(sub, count))
+	return;
+#endif /* IO_URING_ENABLE */
+    batch_resolve(iov, batch.part, count);
+    (void)gathered_write(sub, iov, count);
+#ifdef IO_URING_ENABLE
+    /* staged batches may still point into the arena */
+    if (nsends == 0)
+#endif /* IO_URING_ENABLE */
+	batch.used = 0;
+}
+
+static void batch_finish(void)
+/* the cycle is over, get everything out */
+{
+    batch_flush();
+#ifdef IO_URING_ENABLE
+    uring_send_all();
+#endif /* IO_URING_ENABLE */
+    batch.used = 0;
+}
 
+static void batch_write(struct subscriber_t *sub,
+			const char *buf, size_t len, bool copy)
+/* add output to the client's batch; copy it unless it outlives the cycle */
+{
+    log_client_write(sub, buf, len);
+    if (batch.sub != sub || batch.count == BATCH_MAX)
+	batch_flush();
+    if (copy) {
+	if (batch.used + len > batch.size) {
+	    size_t newsize = batch.size ? batch.size : BUFSIZ;
+	    char *newarena;
+
+	    while (newsize < batch.used + len)
+		newsize *= 2;
+	    if ((newarena = realloc(batch.arena, newsize)) == NULL) {
+		/* can't batch it, so at least keep the order */
+		struct iovec iov;
+
+		batch_finish();
+		iov.iov_base = (char *)buf;
+		iov.iov_len = len;
+		(void)gathered_write(sub, &iov, 1);
+		return;
+	    }
+	    batch.arena = newarena;
+	    batch.size = newsize;
+	}
+	memcpy(batch.arena + batch.used, buf, len);
+	batch.part[batch.count].buf = NULL;
+	batch.part[batch.count].off = batch.used;
+	batch.used += len;
+    } else
+	batch.part[batch.count].buf = buf;
+    batch.part[batch.count].len = len;
+    batch.count++;
+    batch.sub = sub;
+}
+
+static void drain_client(struct subscriber_t *sub)
+/* send as much queued output as the client's socket will take */
+{
+    ssize_t status = 0;
+
+    lock_subscriber(sub);
+    while (sub->outq_count > 0) {
+	struct outmsg_t *msg = OUTQ_AT(sub, 0);
+
+#if defined(PPS_ENABLE)
+	gpsd_acquire_reporting_lock();
 #endif /* PPS_ENABLE */
-    if (status == (ssize_t) len)
-	return status;
-    else if (status > -1) {
-	gpsd_log(&context.errout, LOG_INF,
-		 "short write disconnecting client(%d)\n",
-		 sub_index(sub));
-	detach_client(sub);
-	return 0;
-    } else if (errno == EAGAIN || errno == EINTR)
-	return 0;		/* no data written, and errno says to retry */
-    else if (errno == EBADF)
-	gpsd_log(&context.errout, LOG_WARN,
-		 "client(%d) has vanished.\n", sub_index(sub));
-    else if (errno == EWOULDBLOCK
-	     && time(NULL) - sub->active > NOREAD_TIMEOUT)
-	gpsd_log(&context.errout, LOG_INF,
-		 "client(%d) timed out.\n", sub_index(sub));
-    else
+	status = send(sub->fd, msg->buf + sub->outq_sent,
+		      msg->len - sub->outq_sent, 0);
+#if defined(PPS_ENABLE)
+	gpsd_release_reporting_lock();
+#endif /* PPS_ENABLE */
+	if (status == -1) {
+	    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+		status = 0;
+	    break;
+	}
+	sub->outq_moved = time(NULL);
+	sub->outq_sent += (size_t)status;
+	if (sub->outq_sent < msg->len)
+	    break;
+	sub->outq_sent = 0;
+	outq_drop(sub, 0);
+    }
+    if (sub->outq_count == 0)
+	watch_output(sub->fd, owner_client, sub_index(sub), false);
+    unlock_subscriber(sub);
+    if (status == -1) {
 	gpsd_log(&context.errout, LOG_INF,
 		 "client(%d) write: %s\n",
 		 sub_index(sub), strerror(errno));
-    detach_client(sub);
-    return status;
+	detach_client(sub);
+    }
+}
+
+static void notify_watchers(struct gps_device_t *device,
+			    bool onjson, bool onpps,
+			    const char *sentence, ...)
+/* notify all JSON-watching clients of a given device about an event */
+{
+    va_list ap;
+    char buf[BUFSIZ];
+    struct subscriber_t *sub;
+    struct watcher_list_t *wl = &device_watchers[device - devices];
+    int ci;
+
+    va_start(ap, sentence);
+    (void)vsnprintf(buf, sizeof(buf), sentence, ap);
+    va_end(ap);
+
+    lock_clients();
+    for (ci = wl->count - 1; ci >= 0; ci--) {
+	sub = wl->subs[ci];
+	if (sub->active != 0 && subscribed(sub, device)) {
+	    if ((onjson && sub->policy.json) || (onpps && sub->policy.pps))
+		(void)throttled_write(sub, buf, strlen(buf));
+	}
+    }
+    unlock_clients();
+}
+#endif /* SOCKET_EXPORT_ENABLE */
+
+#ifdef READER_THREADS_ENABLE
+/*
+ * Reader threads.  In this mode each active device gets a thread of
+ * its own that waits for input, reads it, and runs the lexer and the
+ * driver parser through gpsd_multipoll(), so a chatty receiver is
+ * decoded in parallel with everything else instead of ahead of it.
+ *
+ * Reports are rendered from the live device state, so a reader that
+ * has decoded an update posts it in its hand-off slot, writes a byte
+ * on wake_pipe, and parks on the reported semaphore until the main
+ * (reporting) thread has run all_reports() for it.  There is no queue
+ * to run ahead into: letting the reader go on would mean snapshotting
+ * the whole gps_device_t per update.  What runs in parallel is the
+ * devices with each other, and each device with client service.
+ *
+ * Shared state, and who may touch it:
+ *  - the gps_device_t, lexer included, belongs to its reader while
+ *    the reader holds its lock.  The main thread reads it only while
+ *    the reader is parked, or under lock_readers() for client
+ *    commands, which may open, close or reconfigure any device.
+ *    Readers hold their lock only across one read-and-decode pass.
+ *  - the gps_context_t is common to all devices.  Drivers update its
+ *    time fields (leap_seconds, gps_week, gps_tow, century, valid)
+ *    with plain word stores and no lock; the last writer wins, as
+ *    the last device to report did before.
+ *  - driver and lexer lookup tables (DFA tables, the NMEA tag index,
+ *    the UBX dispatch index, CRC tables) are read-only once the
+ *    reader threads can start.  Parsers must keep no other static
+ *    state.
+ *  - gpsd_log() serializes itself.
+ */
+
+struct reader_t {
+    pthread_t thread;
+    bool running;
+    volatile bool stopping;
+    int wake[2];			/* interrupts the reader's poll() */
+    pthread_mutex_t lock;		/* held while the reader decodes */
+    sem_t reported;			/* the main thread is done with it */
+    struct {
+	gps_mask_t changed;
+	int status;			/* DEVICE_READY, or why it stopped */
+    } handoff;
+    volatile bool pending;		/* handoff is filled in, unreported */
+};
+static struct reader_t readers[MAX_DEVICES];
+
+static void reader_handoff(struct reader_t *rd, gps_mask_t changed,
+			   int status)
+/* post an update for the main thread and wake it */
+{
+    rd->handoff.changed = changed;
+    rd->handoff.status = status;
+    memory_barrier();
+    rd->pending = true;
+    ignore_return(write(wake_pipe[1], "", 1));
+}
+
+static void reader_report(struct gps_device_t *device, gps_mask_t changed)
+/* gpsd_multipoll() handler on a reader thread */
+{
+    struct reader_t *rd = &readers[device - devices];
+
+    if (rd->stopping)
+	return;
+    reader_handoff(rd, changed, DEVICE_READY);
+    (void)pthread_mutex_unlock(&rd->lock);
+    while (sem_wait(&rd->reported) == -1 && errno == EINTR)
+	continue;
+    (void)pthread_mutex_lock(&rd->lock);
+}
+
+static void *reader_thread(void *arg)
+/* read and decode one device until it fails or we are told to stop */
+{
+    struct gps_device_t *device = (struct gps_device_t *)arg;
+    struct reader_t *rd = &readers[device - devices];
+    struct pollfd pfd[2];
+    int status = DEVICE_READY;
+
+    pfd[0].fd = device->gpsdata.gps_fd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = rd->wake[0];
+    pfd[1].events = POLLIN;
+    while (!rd->stopping) {
+	if (poll(pfd, NITEMS(pfd), -1) == -1) {
+	    if (errno == EINTR)
+		continue;
+	    status = DEVICE_ERROR;
+	    break;
+	}
+	if (rd->stopping)
+	    break;
+	if (pfd[0].revents == 0)
+	    continue;
+
+	(void)pthread_mutex_lock(&rd->lock);
+	status = gpsd_multipoll(true, device, reader_report, DEVICE_REAWAKE);
+	if (status == DEVICE_UNREADY) {
+	    /* zero-length read; let the buffer refill, then try once more */
+	    struct timespec delay = {0, (long)(DEVICE_REAWAKE * 1e9)};
+
+	    (void)pthread_mutex_unlock(&rd->lock);
+	    (void)nanosleep(&delay, NULL);
+	    (void)pthread_mutex_lock(&rd->lock);
+	    device->reawake = (time_t)0;
+	    device->zerokill = true;
+	    status = DEVICE_READY;
+	}
+	/* a second zero-length read closes the device under us */
+	if (device->gpsdata.gps_fd != pfd[0].fd)
+	    status = DEVICE_EOF;
+	(void)pthread_mutex_unlock(&rd->lock);
+	if (status == DEVICE_ERROR || status == DEVICE_EOF)
+	    break;
+    }
+    if (!rd->stopping)
+	reader_handoff(rd, 0, status);
+    return NULL;
+}
+
+static void start_reader(struct gps_device_t *device)
+/* give an activated device its reader thread */
+{
+    struct reader_t *rd = &readers[device - devices];
+    char c;
+
+    if (rd->running)
+	return;
+    while (read(rd->wake[0], &c, 1) == 1)
+	continue;
+    rd->stopping = false;
+    rd->pending = false;
+    (void)sem_init(&rd->reported, 0, 0);
+    if (pthread_create(&rd->thread, NULL, reader_thread, device) != 0) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't start reader thread for %s: %s\n",
+		 device->gpsdata.dev.path, strerror(errno));
+	return;
+    }
+    rd->running = true;
+    gpsd_log(&context.errout, LOG_PROG,
+	     "reader thread started for %s\n", device->gpsdata.dev.path);
+}
+
+static void stop_reader(struct gps_device_t *device)
+/* stop a device's reader thread and drop whatever it left queued */
+{
+    struct reader_t *rd = &readers[device - devices];
+
+    if (!rd->running)
+	return;
+    rd->stopping = true;
+    ignore_return(write(rd->wake[1], "", 1));
+    (void)sem_post(&rd->reported);	/* in case it is parked */
+    (void)pthread_join(rd->thread, NULL);
+    (void)sem_destroy(&rd->reported);
+    rd->running = false;
+    rd->pending = false;
+}
+
+static void lock_readers(void)
+/* keep reader threads off their devices */
+{
+    int di;
+
+    for (di = 0; di < MAX_DEVICES; di++)
+	(void)pthread_mutex_lock(&readers[di].lock);
 }
 
-static void notify_watchers(struct gps_device_t *device,
-			    bool onjson, bool onpps,
-			    const char *sentence, ...)
-/* notify all JSON-watching clients of a given device about an event */
+static void unlock_readers(void)
 {
-    va_list ap;
-    char buf[BUFSIZ];
-    struct subscriber_t *sub;
+    int di;
 
-    va_start(ap, sentence);
-    (void)vsnprintf(buf, sizeof(buf), sentence, ap);
-    va_end(ap);
+    for (di = MAX_DEVICES - 1; di >= 0; di--)
+	(void)pthread_mutex_unlock(&readers[di].lock);
+}
+#endif /* READER_THREADS_ENABLE */
 
-    for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++)
-	if (sub->active != 0 && subscribed(sub, device)) {
-	    if ((onjson && sub->policy.json) || (onpps && sub->policy.pps))
-		(void)throttled_write(sub, buf, strlen(buf));
-	}
+static void watch_device(struct gps_device_t *device)
+/* start servicing input from an activated device */
+{
+#ifdef READER_THREADS_ENABLE
+    start_reader(device);
+#else
+    (void)watch_fd(device->gpsdata.gps_fd, owner_device,
+		   (int)(device - devices));
+#endif /* READER_THREADS_ENABLE */
+}
+
+static void unwatch_device(struct gps_device_t *device)
+/* stop servicing input from a device */
+{
+#ifdef READER_THREADS_ENABLE
+    stop_reader(device);
+#else
+    unwatch_fd(device->gpsdata.gps_fd);
+#endif /* READER_THREADS_ENABLE */
 }
-#endif /* SOCKET_EXPORT_ENABLE */
 
 static void deactivate_device(struct gps_device_t *device)
 /* deactivate device, but leave it in the pool (do not free it) */
@@ -674,8 +1861,7 @@ static void deactivate_device(struct gps_device_t *device)
 		    device->gpsdata.dev.path);
 #endif /* SOCKET_EXPORT_ENABLE */
     if (!BAD_SOCKET(device->gpsdata.gps_fd)) {
-	FD_CLR(device->gpsdata.gps_fd, &all_fds);
-	adjust_max_fd(device->gpsdata.gps_fd, false);
+	unwatch_device(device);
 #ifdef NTPSHM_ENABLE
 	ntpshm_link_deactivate(device);
 #endif /* NTPSHM_ENABLE */
@@ -738,8 +1924,7 @@ static bool open_device( struct gps_device_t *device)
 	/* it is a /dev/ppsX, no need to select() it */
         return true;
     }
-    FD_SET(device->gpsdata.gps_fd, &all_fds);
-    adjust_max_fd(device->gpsdata.gps_fd, true);
+    watch_device(device);
     ++highwater;
     return true;
 }
@@ -766,6 +1951,9 @@ bool gpsd_add_device(const char *device_name, bool flag_nowait)
 #ifdef NTPSHM_ENABLE
 	    ntpshm_session_init(devp);
 #endif /* NTPSHM_ENABLE */
+#ifdef SOCKET_EXPORT_ENABLE
+	    reindex_device(devp);
+#endif /* SOCKET_EXPORT_ENABLE */
 	    gpsd_log(&context.errout, LOG_INF,
 		     "stashing device %s at slot %d\n",
 		     device_name, (int)(devp - devices));
@@ -812,6 +2000,8 @@ static int write_gps(char *device, char *hex) {
     gpsd_log(&context.errout, LOG_INF,
 	     "GPS <=: writing %d bytes fromhex(%s) to %s\n",
 	     st, hex, device);
+    /* who knows what the device will send back */
+    gpsd_lexer_unsettle(devp);
     if (write(devp->gpsdata.gps_fd, hex, (size_t) st) <= 0) {
 	gpsd_log(&context.errout, LOG_WARN,
 		 "GPS <=: write to device failed\n");
@@ -987,8 +2177,7 @@ static bool awaken(struct gps_device_t *device)
 	    gpsd_log(&context.errout, LOG_RAW,
 			"flagging descriptor %d in assign_channel()\n",
 			device->gpsdata.gps_fd);
-	    FD_SET(device->gpsdata.gps_fd, &all_fds);
-	    adjust_max_fd(device->gpsdata.gps_fd, true);
+	    watch_device(device);
 	    return true;
 	}
     }
@@ -1001,11 +2190,15 @@ static bool privileged_user(struct gps_device_t *device)
 {
     /* grant user privilege if he's the only one listening to the device */
     struct subscriber_t *sub;
-    int subcount = 0;
-    for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++) {
+    struct watcher_list_t *wl = &device_watchers[device - devices];
+    int ci, subcount = 0;
+    lock_clients();
+    for (ci = 0; ci < wl->count; ci++) {
+	sub = wl->subs[ci];
 	if (subscribed(sub, device))
 	    subcount++;
     }
+    unlock_clients();
     /*
      * Yes, zero subscribers is possible. For example, gpsctl talking
      * to the daemon connects but doesn't necessarily issue a ?WATCH
@@ -1134,6 +2327,7 @@ static void handle_request(struct subscriber_t *sub,
 #ifndef TIMING_ENABLE
 	    sub->policy.timing = false;
 #endif /* TIMING_ENABLE */
+	    reindex_client(sub);
 	    if (end == NULL)
 		buf += strlen(buf);
 	    else {
@@ -1196,8 +2390,11 @@ static void handle_request(struct subscriber_t *sub,
 	} else {
 #ifdef RECONFIGURE_ENABLE
 	    struct gps_device_t *device;
+	    char protocols[GPS_JSON_PROTOCOLS_MAX];
 	    /* first, select a device to operate on */
-	    int status = json_device_read(buf + 1, &devconf, &end);
+	    int status = json_device_read(buf + 1, &devconf,
+					  protocols, sizeof(protocols),
+					  &end);
 	    if (end == NULL)
 		buf += strlen(buf);
 	    else {
@@ -1274,8 +2471,21 @@ static void handle_request(struct subscriber_t *sub,
 		    /* now that channel is selected, apply changes */
 		    if (devconf.driver_mode != device->gpsdata.dev.driver_mode
 			&& devconf.driver_mode != DEVDEFAULT_NATIVE
-			&& dt->mode_switcher != NULL)
+			&& dt->mode_switcher != NULL) {
 			dt->mode_switcher(device, devconf.driver_mode);
+			gpsd_lexer_unsettle(device);
+		    }
+		    if ('\0' != protocols[0]) {
+			unsigned int types;
+			if (json_protocols_read(protocols, &types) != 0)
+			    str_appendf(reply, replylen,
+					"{\"class\":\"ERROR\",\"message\":\"Unknown protocol in %s\"}\r\n",
+					protocols);
+			else {
+			    device->pinned_types = types;
+			    gpsd_lexer_unsettle(device);
+			}
+		    }
 		    if (!no_serial_change) {
 			char serialmode[3];
 			serialmode[0] = devconf.parity;
@@ -1390,9 +2600,8 @@ static void raw_report(struct subscriber_t *sub, struct gps_device_t *device)
      */
     if (TEXTUAL_PACKET_TYPE(device->lexer.type)
 	&& (sub->policy.raw > 0 || sub->policy.nmea)) {
-	(void)throttled_write(sub,
-			      (char *)device->lexer.outbuffer,
-			      device->lexer.outbuflen);
+	batch_write(sub, (const char *)device->lexer.frame,
+		    device->lexer.outbuflen, false);
 	return;
     }
 
@@ -1401,9 +2610,8 @@ static void raw_report(struct subscriber_t *sub, struct gps_device_t *device)
      * super-raw mode.
      */
     if (sub->policy.raw > 1) {
-	(void)throttled_write(sub,
-			      (char *)device->lexer.outbuffer,
-			      device->lexer.outbuflen);
+	batch_write(sub, (const char *)device->lexer.frame,
+		    device->lexer.outbuflen, false);
 	return;
     }
 #ifdef BINARY_ENABLE
@@ -1413,10 +2621,11 @@ static void raw_report(struct subscriber_t *sub, struct gps_device_t *device)
     if (sub->policy.raw == 1) {
 	const char *hd =
 	    gpsd_hexdump(device->msgbuf, sizeof(device->msgbuf),
-			 (char *)device->lexer.outbuffer,
+			 (const char *)device->lexer.frame,
 			 device->lexer.outbuflen);
 	(void)strlcat((char *)hd, "\r\n", sizeof(device->msgbuf));
-	(void)throttled_write(sub, (char *)hd, strlen(hd));
+	/* msgbuf is rewritten for the next client, so copy */
+	batch_write(sub, hd, strlen(hd), true);
     }
 #endif /* BINARY_ENABLE */
 }
@@ -1435,7 +2644,7 @@ static void pseudonmea_report(struct subscriber_t *sub,
 	    gpsd_log(&context.errout, LOG_IO,
 		     "<= GPS (binary tpv) %s: %s\n",
 		     device->gpsdata.dev.path, buf);
-	    (void)throttled_write(sub, buf, strlen(buf));
+	    batch_write(sub, buf, strlen(buf), true);
 	}
 
 	if ((changed & (SATELLITE_SET|USED_IS)) != 0) {
@@ -1443,7 +2652,7 @@ static void pseudonmea_report(struct subscriber_t *sub,
 	    gpsd_log(&context.errout, LOG_IO,
 		     "<= GPS (binary sky) %s: %s\n",
 		     device->gpsdata.dev.path, buf);
-	    (void)throttled_write(sub, buf, strlen(buf));
+	    batch_write(sub, buf, strlen(buf), true);
 	}
 
 	if ((changed & SUBFRAME_SET) != 0) {
@@ -1451,7 +2660,7 @@ static void pseudonmea_report(struct subscriber_t *sub,
 	    gpsd_log(&context.errout, LOG_IO,
 		     "<= GPS (binary subframe) %s: %s\n",
 		     device->gpsdata.dev.path, buf);
-	    (void)throttled_write(sub, buf, strlen(buf));
+	    batch_write(sub, buf, strlen(buf), true);
 	}
 #ifdef AIVDM_ENABLE
 	if ((changed & AIS_SET) != 0) {
@@ -1459,11 +2668,49 @@ static void pseudonmea_report(struct subscriber_t *sub,
 	    gpsd_log(&context.errout, LOG_IO,
 		     "<= AIS (binary ais) %s: %s\n",
 		     device->gpsdata.dev.path, buf);
-	    (void)throttled_write(sub, buf, strlen(buf));
+	    batch_write(sub, buf, strlen(buf), true);
 	}
 #endif /* AIVDM_ENABLE */
     }
 }
+
+/*
+ * Encode cache for JSON data reports.  The rendering of a report
+ * depends only on the device state and on the scaled and timing bits
+ * of the watcher's policy, so each variant is produced at most once
+ * per report and the same bytes go to every client that wants it.
+ * Entries are keyed by device and report sequence number; all_reports()
+ * bumps the sequence, which invalidates everything at once.
+ */
+#define REPORT_VARIANT(policy)	(((policy)->scaled ? 1 : 0) | ((policy)->timing ? 2 : 0))
+#define REPORT_VARIANTS	4
+#define REPORT_MAX	(GPS_JSON_RESPONSE_MAX * 4 + GPS_JSON_RAW_MAX)
+
+struct report_cache_t
+{
+    const struct gps_device_t *device;
+    unsigned long seq;
+    size_t len;
+    char buf[REPORT_MAX];
+};
+static struct report_cache_t report_cache[REPORT_VARIANTS];
+static unsigned long report_seq;
+
+static struct report_cache_t *cached_data_report(gps_mask_t changed,
+					struct gps_device_t *device,
+					const struct gps_policy_t *policy)
+/* return the JSON rendering of the current report for this policy */
+{
+    struct report_cache_t *rc = &report_cache[REPORT_VARIANT(policy)];
+
+    if (rc->device != device || rc->seq != report_seq) {
+	json_data_report(changed, device, policy, rc->buf, sizeof(rc->buf));
+	rc->len = strlen(rc->buf);
+	rc->device = device;
+	rc->seq = report_seq;
+    }
+    return rc;
+}
 #endif /* SOCKET_EXPORT_ENABLE */
 
 static void all_reports(struct gps_device_t *device, gps_mask_t changed)
@@ -1471,16 +2718,21 @@ static void all_reports(struct gps_device_t *device, gps_mask_t changed)
 {
 #ifdef SOCKET_EXPORT_ENABLE
     struct subscriber_t *sub;
+    struct watcher_list_t *wl = &device_watchers[device - devices];
+    int ci;
 
     /* add any just-identified device to watcher lists */
     if ((changed & DRIVER_IS) != 0) {
 	bool listeners = false;
-	for (sub = subscribers;
-	     sub < subscribers + MAX_CLIENTS; sub++)
+	lock_clients();
+	for (ci = 0; ci < wl->count; ci++) {
+	    sub = wl->subs[ci];
 	    if (sub->active != 0
 		&& sub->policy.watcher
 		&& subscribed(sub, device))
 		listeners = true;
+	}
+	unlock_clients();
 	if (listeners) {
 	    (void)awaken(device);
 	}
@@ -1522,7 +2774,7 @@ static void all_reports(struct gps_device_t *device, gps_mask_t changed)
 /* *INDENT-OFF* */
 		    if (dp->device_type->rtcm_writer != NULL) {
 			if (dp->device_type->rtcm_writer(dp,
-							     (const char *)device->lexer.outbuffer,
+							     (const char *)device->lexer.frame,
 							     device->lexer.outbuflen) == 0)
 			    gpsd_log(&context.errout, LOG_ERROR,
 				     "Write to RTCM sink failed\n");
@@ -1628,15 +2880,18 @@ static void all_reports(struct gps_device_t *device, gps_mask_t changed)
     }
 
 #ifdef SHM_EXPORT_ENABLE
-    if ((changed & (REPORT_IS|GST_SET|SATELLITE_SET|SUBFRAME_SET|
+    if ((changed & (REPORT_IS|GST_SET|SATELLITE_SET|SUBFRAME_SET|RAW_SET|
 		    ATTITUDE_SET|RTCM2_SET|RTCM3_SET|AIS_SET)) != 0)
 	shm_update(&context, &device->gpsdata);
 #endif /* SHM_EXPORT_ENABLE */
 
 #ifdef SOCKET_EXPORT_ENABLE
     /* update all subscribers associated with this device */
-    for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++) {
-	if (sub == NULL || sub->active == 0 || !subscribed(sub, device))
+    ++report_seq;
+    lock_clients();
+    for (ci = wl->count - 1; ci >= 0; ci--) {
+	sub = wl->subs[ci];
+	if (sub->active == 0 || !subscribed(sub, device))
 	    continue;
 
 #ifdef PASSTHROUGH_ENABLE
@@ -1673,7 +2928,7 @@ static void all_reports(struct gps_device_t *device, gps_mask_t changed)
 
 		if (sub->policy.json)
 		{
-		    char buf[GPS_JSON_RESPONSE_MAX * 4];
+		    struct report_cache_t *rc;
 
 		    if ((changed & AIS_SET) != 0)
 			if (device->gpsdata.ais.type == 24
@@ -1681,19 +2936,47 @@ static void all_reports(struct gps_device_t *device, gps_mask_t changed)
 			    && !sub->policy.split24)
 			    continue;
 
-		    json_data_report(changed,
-				     device, &sub->policy,
-				     buf, sizeof(buf));
-		    if (buf[0] != '\0')
-			(void)throttled_write(sub, buf, strlen(buf));
+		    rc = cached_data_report(changed, device, &sub->policy);
+		    if (rc->len > 0)
+			batch_write(sub, rc->buf, rc->len, false);
 
 		}
 	    }
 	}
     } /* subscribers */
+    batch_finish();
+    unlock_clients();
 #endif /* SOCKET_EXPORT_ENABLE */
 }
 
+#ifdef READER_THREADS_ENABLE
+static void collect_reader(struct gps_device_t *device)
+/* report the update a device's reader thread has handed off */
+{
+    struct reader_t *rd = &readers[device - devices];
+
+    gps_mask_t changed;
+    int status;
+
+    if (!rd->running || !rd->pending)
+	return;
+    memory_barrier();
+    changed = rd->handoff.changed;
+    status = rd->handoff.status;
+    rd->pending = false;
+    if (status != DEVICE_READY) {
+	/* the reader has exited, reap it before touching the device */
+	(void)pthread_join(rd->thread, NULL);
+	(void)sem_destroy(&rd->reported);
+	rd->running = false;
+	deactivate_device(device);
+	return;
+    }
+    all_reports(device, changed);
+    (void)sem_post(&rd->reported);
+}
+#endif /* READER_THREADS_ENABLE */
+
 #ifdef SOCKET_EXPORT_ENABLE
 /* Execute GPSD requests (?POLL, ?WATCH, etc.) from a buffer.
  * The entire request must be in the buffer.
@@ -1826,6 +3109,214 @@ static void netgnss_autoconnect(struct gps_context_t *context,
 }
 #endif /* __UNUSED_AUTOCONNECT__ */
 
+#ifdef SOCKET_EXPORT_ENABLE
+struct ready_client_t {
+    struct subscriber_t *sub;
+    int fd;			/* to tell if the slot changed hands */
+};
+
+static bool over_budget(const struct timespec *start)
+/* has this pass used up its time for client work? */
+{
+    struct timespec now;
+    long spent;
+
+    if (client_budget <= 0)
+	return false;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    spent = (now.tv_sec - start->tv_sec) * 1000000L
+	+ (now.tv_nsec - start->tv_nsec) / 1000L;
+    return spent >= client_budget;
+}
+
+/*
+ * Client admission.  After a restart hundreds of clients may reconnect
+ * at once.  Taking them all in one pass would hold up device input, so
+ * each trip through the main loop admits at most ACCEPT_BUDGET of them,
+ * and only after the devices have been polled.  With accept_thread=yes
+ * the accept(2) calls happen on a thread of their own, which queues
+ * the connected descriptors for the main loop to pick up.
+ */
+#define ACCEPT_BUDGET	16
+
+static void admit_client(socket_t ssock)
+/* set up a freshly accepted client connection */
+{
+    struct subscriber_t *client = NULL;
+    int opts = fcntl(ssock, F_GETFL);
+    static struct linger linger = { 1, RELEASE_TIMEOUT };
+    char *c_ip;
+
+    if (opts >= 0)
+	(void)fcntl(ssock, F_SETFL, opts | O_NONBLOCK);
+
+    c_ip = netlib_sock2ip(ssock);
+    client = allocate_client();
+    if (client == NULL) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "Client %s connect on fd %d -"
+		 "no subscriber slots available\n", c_ip,
+		 ssock);
+	(void)close(ssock);
+    } else
+	if (setsockopt
+	    (ssock, SOL_SOCKET, SO_LINGER, (char *)&linger,
+	     (int)sizeof(struct linger)) == -1) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "Error: SETSOCKOPT SO_LINGER\n");
+	(void)close(ssock);
+	lock_clients();
+	free_client(client);
+	unlock_clients();
+    } else if (!watch_fd(ssock, owner_client, sub_index(client))) {
+	(void)close(ssock);
+	lock_clients();
+	free_client(client);
+	unlock_clients();
+    } else {
+	char announce[GPS_JSON_RESPONSE_MAX];
+	client->fd = ssock;
+	client->active = time(NULL);
+	gpsd_log(&context.errout, LOG_SPIN,
+		 "client %s (%d) connect on fd %d\n", c_ip,
+		 sub_index(client), ssock);
+	json_version_dump(announce, sizeof(announce));
+	(void)throttled_write(client, announce, strlen(announce));
+    }
+}
+
+#ifndef ACCEPT_THREAD_ENABLE
+static void accept_clients(const socket_t *socks, const bool *ready)
+/* admit connections waiting on the ready listeners, within the budget */
+{
+    int i, budget = ACCEPT_BUDGET;
+
+    for (i = 0; i < AFCOUNT; i++)
+	while (budget > 0 && socks[i] >= 0 && ready[i]) {
+	    socket_t ssock = accept(socks[i], NULL, NULL);
+
+	    if (BAD_SOCKET(ssock)) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		    gpsd_log(&context.errout, LOG_ERROR,
+			     "accept: %s\n", strerror(errno));
+		break;
+	    }
+	    admit_client(ssock);
+	    budget--;
+	}
+    /* level-triggered wakeups bring us back for any that are left */
+}
+#else
+#define ACCEPT_QUEUE	64
+
+static struct {
+    pthread_t thread;
+    socket_t socks[AFCOUNT];
+    int wake[2];		/* tells the main loop there are arrivals */
+    pthread_mutex_t lock;
+    pthread_cond_t room;	/* signalled when the main loop takes some */
+    socket_t queue[ACCEPT_QUEUE];
+    int head, count;
+} acceptor = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .room = PTHREAD_COND_INITIALIZER,
+};
+
+static void *acceptor_thread(void *arg UNUSED)
+/* accept client connections and queue them for the main loop */
+{
+    struct pollfd pfd[AFCOUNT];
+    nfds_t i, n = 0;
+    sigset_t all;
+
+    /* signals are the main loop's business */
+    (void)sigfillset(&all);
+    (void)pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+    for (i = 0; i < AFCOUNT; i++)
+	if (acceptor.socks[i] >= 0) {
+	    pfd[n].fd = acceptor.socks[i];
+	    pfd[n].events = POLLIN;
+	    n++;
+	}
+    for (;;) {
+	if (poll(pfd, n, -1) == -1) {
+	    if (errno == EINTR)
+		continue;
+	    gpsd_log(&context.errout, LOG_ERROR,
+		     "accept thread poll: %s\n", strerror(errno));
+	    return NULL;
+	}
+	for (i = 0; i < n; i++) {
+	    socket_t ssock;
+
+	    if ((pfd[i].revents & POLLIN) == 0)
+		continue;
+	    ssock = accept(pfd[i].fd, NULL, NULL);
+	    if (BAD_SOCKET(ssock)) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK
+		    && errno != ECONNABORTED && errno != EINTR)
+		    gpsd_log(&context.errout, LOG_ERROR,
+			     "accept: %s\n", strerror(errno));
+		continue;
+	    }
+	    /* leave the rest in the backlog until the main loop catches up */
+	    (void)pthread_mutex_lock(&acceptor.lock);
+	    while (acceptor.count == ACCEPT_QUEUE)
+		(void)pthread_cond_wait(&acceptor.room, &acceptor.lock);
+	    acceptor.queue[(acceptor.head + acceptor.count++) % ACCEPT_QUEUE]
+		= ssock;
+	    (void)pthread_mutex_unlock(&acceptor.lock);
+	    ignore_return(write(acceptor.wake[1], "", 1));
+	}
+    }
+}
+
+static void start_acceptor(const socket_t *socks)
+/* hand the listening sockets to the accept thread */
+{
+    int i;
+
+    for (i = 0; i < AFCOUNT; i++)
+	acceptor.socks[i] = socks[i];
+    if (open_wake_pipe(acceptor.wake) == -1) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't create accept wakeup pipe: %s\n", strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+    if (pthread_create(&acceptor.thread, NULL, acceptor_thread, NULL) != 0) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't start accept thread: %s\n", strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+}
+
+static void collect_accepted(void)
+/* admit what the accept thread queued, within the budget */
+{
+    int admitted;
+
+    for (admitted = 0; admitted < ACCEPT_BUDGET; admitted++) {
+	socket_t ssock;
+
+	(void)pthread_mutex_lock(&acceptor.lock);
+	if (acceptor.count == 0) {
+	    (void)pthread_mutex_unlock(&acceptor.lock);
+	    return;
+	}
+	ssock = acceptor.queue[acceptor.head];
+	acceptor.head = (acceptor.head + 1) % ACCEPT_QUEUE;
+	acceptor.count--;
+	(void)pthread_cond_signal(&acceptor.room);
+	(void)pthread_mutex_unlock(&acceptor.lock);
+	admit_client(ssock);
+    }
+    /* over budget; make sure the next pass comes back for the rest */
+    ignore_return(write(acceptor.wake[1], "", 1));
+}
+#endif /* ACCEPT_THREAD_ENABLE */
+#endif /* SOCKET_EXPORT_ENABLE */
+
 #ifdef PPS_ENABLE
 #define CONDITIONALLY_UNUSED
 #else
@@ -1838,6 +3329,9 @@ static void gpsd_terminate(struct gps_context_t *context CONDITIONALLY_UNUSED)
 
     for (dfd = 0; dfd < MAX_DEVICES; dfd++) {
 	if (allocated_device(&devices[dfd])) {
+#ifdef READER_THREADS_ENABLE
+	    stop_reader(&devices[dfd]);
+#endif /* READER_THREADS_ENABLE */
 	    (void)gpsd_wrap(&devices[dfd]);
 	}
     }
@@ -1853,13 +3347,10 @@ int main(int argc, char *argv[])
     static char *gpsd_service = NULL;
     struct subscriber_t *sub;
 #endif /* SOCKET_EXPORT_ENABLE */
-    fd_set rfds;
-#ifdef CONTROL_SOCKET_ENABLE
-    fd_set control_fds;
-#endif /* CONTROL_SOCKET_ENABLE */
+    static struct fd_event_t events[MAX_EVENTS];
+    bool device_ready[MAX_DEVICES];
 #ifdef CONTROL_SOCKET_ENABLE
     static socket_t csock;
-    socket_t cfd;
     static char *control_socket = NULL;
 #endif /* CONTROL_SOCKET_ENABLE */
 #if defined(SOCKET_EXPORT_ENABLE) || defined(CONTROL_SOCKET_ENABLE)
@@ -1874,6 +3365,7 @@ int main(int argc, char *argv[])
     volatile bool in_restart;
 
     gps_context_init(&context, "gpsd");
+    context.settle_lexer = true;
 
 #ifdef CONTROL_SOCKET_ENABLE
     INVALIDATE_SOCKET(csock);
@@ -1882,8 +3374,14 @@ int main(int argc, char *argv[])
 #endif /* PPS_ENABLE && SOCKET_EXPORT_ENABLE */
 #endif /* CONTROL_SOCKET_ENABLE */
 
-    while ((option = getopt(argc, argv, "F:D:S:bGhlNnrP:V")) != -1) {
+    while ((option = getopt(argc, argv, "B:F:D:S:bGhlLNnO:rP:Q:V")) != -1) {
 	switch (option) {
+	case 'B':
+#ifdef SOCKET_EXPORT_ENABLE
+	    /* 0 means no limit */
+	    client_budget = strtol(optarg, 0, 0);
+#endif /* SOCKET_EXPORT_ENABLE */
+	    break;
 	case 'D':
 	    context.errout.debug = (int)strtol(optarg, 0, 0);
 #ifdef CLIENTDEBUG_ENABLE
@@ -1909,6 +3407,9 @@ int main(int argc, char *argv[])
 	case 'l':		/* list known device types and exit */
 	    typelist();
 	    break;
+	case 'L':
+	    context.settle_lexer = false;
+	    break;
 	case 'S':
 #ifdef SOCKET_EXPORT_ENABLE
 	    gpsd_service = optarg;
@@ -1922,9 +3423,31 @@ int main(int argc, char *argv[])
 	case 'r':
 	    batteryRTC = true;
 	    break;
+	case 'O':
+#ifdef SOCKET_EXPORT_ENABLE
+	    if (strcmp(optarg, "oldest") == 0)
+		overflow_policy = overflow_oldest;
+	    else if (strcmp(optarg, "class") == 0)
+		overflow_policy = overflow_class;
+	    else if (strcmp(optarg, "disconnect") == 0)
+		overflow_policy = overflow_disconnect;
+	    else {
+		usage();
+		exit(EXIT_FAILURE);
+	    }
+#endif /* SOCKET_EXPORT_ENABLE */
+	    break;
 	case 'P':
 	    pid_file = optarg;
 	    break;
+	case 'Q':
+#ifdef SOCKET_EXPORT_ENABLE
+	    client_queue = (size_t)strtoul(optarg, 0, 0);
+	    /* room for at least one full report */
+	    if (client_queue < REPORT_MAX)
+		client_queue = REPORT_MAX;
+#endif /* SOCKET_EXPORT_ENABLE */
+	    break;
 	case 'V':
 	    (void)printf("%s: %s (revision %s)\n", argv[0], VERSION, REVISION);
 	    exit(EXIT_SUCCESS);
@@ -1943,6 +3466,51 @@ int main(int argc, char *argv[])
 	exit(1);
     }
 
+#ifdef EPOLL_ENABLE
+    if ((epfd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't create epoll instance: %s\n", strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+#endif /* EPOLL_ENABLE */
+
+#ifdef IO_URING_ENABLE
+    uring_active = uring_init(URING_ENTRIES, &context.errout);
+#ifndef READER_THREADS_ENABLE
+    if (uring_active) {
+	/* device reads land straight in the lexer input buffers */
+	struct iovec inbufs[MAX_DEVICES];
+
+	for (i = 0; i < MAX_DEVICES; i++) {
+	    inbufs[i].iov_base = devices[i].lexer.inbufstore;
+	    inbufs[i].iov_len = sizeof(devices[i].lexer.inbufstore);
+	}
+	uring_reads = uring_register_buffers(inbufs, MAX_DEVICES);
+	if (!uring_reads)
+	    gpsd_log(&context.errout, LOG_INF,
+		     "can't register io_uring buffers (%s), "
+		     "reading devices the plain way\n", strerror(errno));
+    }
+#endif /* READER_THREADS_ENABLE */
+#endif /* IO_URING_ENABLE */
+
+    if (open_wake_pipe(wake_pipe) == -1) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't create wakeup pipe: %s\n", strerror(errno));
+	exit(EXIT_FAILURE);
+    }
+#ifdef READER_THREADS_ENABLE
+    for (i = 0; i < MAX_DEVICES; i++) {
+	if (open_wake_pipe(readers[i].wake) == -1) {
+	    gpsd_log(&context.errout, LOG_ERROR,
+		     "can't create reader wakeup pipe: %s\n",
+		     strerror(errno));
+	    exit(EXIT_FAILURE);
+	}
+	(void)pthread_mutex_init(&readers[i].lock, NULL);
+    }
+#endif /* READER_THREADS_ENABLE */
+
 #if defined(SYSTEMD_ENABLE) && defined(CONTROL_SOCKET_ENABLE)
     sd_socket_count = sd_get_socket_count();
     if (sd_socket_count > 0 && control_socket != NULL) {
@@ -1977,8 +3545,7 @@ int main(int argc, char *argv[])
 #if defined(SYSTEMD_ENABLE) && defined(CONTROL_SOCKET_ENABLE)
     if (sd_socket_count > 0) {
         csock = SD_SOCKET_FDS_START;
-        FD_SET(csock, &all_fds);
-        adjust_max_fd(csock, true);
+        (void)watch_fd(csock, owner_control_listener, 0);
     }
 #endif
 #ifdef CONTROL_SOCKET_ENABLE
@@ -1993,8 +3560,7 @@ int main(int argc, char *argv[])
 	    gpsd_log(&context.errout, LOG_SPIN,
 		     "control socket %s is fd %d\n",
 		     control_socket, csock);
-	FD_SET(csock, &all_fds);
-	adjust_max_fd(csock, true);
+	(void)watch_fd(csock, owner_control_listener, 0);
 	gpsd_log(&context.errout, LOG_PROG,
 		 "control socket opened at %s\n",
 		 control_socket);
@@ -2044,6 +3610,11 @@ int main(int argc, char *argv[])
 	    (void)unlink(pid_file);
 	exit(EXIT_FAILURE);
     }
+    /* admission takes what is there and never waits for more */
+    for (i = 0; i < AFCOUNT; i++)
+	if (msocks[i] >= 0)
+	    (void)fcntl(msocks[i], F_SETFL,
+			fcntl(msocks[i], F_GETFL) | O_NONBLOCK);
     gpsd_log(&context.errout, LOG_INF, "listening on port %s\n", gpsd_service);
 #endif /* SOCKET_EXPORT_ENABLE */
 
@@ -2165,9 +3736,18 @@ int main(int argc, char *argv[])
 	     "running with effective user ID %d\n", geteuid());
 
 #ifdef SOCKET_EXPORT_ENABLE
-    for (i = 0; i < NITEMS(subscribers); i++) {
-	subscribers[i].fd = UNALLOCATED_FD;
-	(void)pthread_mutex_init(&subscribers[i].mutex, NULL);
+    {
+	pthread_mutexattr_t attr;
+
+	(void)pthread_mutexattr_init(&attr);
+	(void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	(void)pthread_mutex_init(&client_lock, &attr);
+	(void)pthread_mutexattr_destroy(&attr);
+    }
+    if (!grow_clients()) {
+	gpsd_log(&context.errout, LOG_ERROR,
+		 "can't allocate the client table.\n");
+	exit(EXIT_FAILURE);
     }
 #endif /* SOCKET_EXPORT_ENABLE*/
 
@@ -2192,6 +3772,10 @@ int main(int argc, char *argv[])
 	(void)signal(SIGPIPE, SIG_IGN);
     }
 
+#if defined(SOCKET_EXPORT_ENABLE) && defined(ACCEPT_THREAD_ENABLE)
+    start_acceptor(msocks);
+#endif /* SOCKET_EXPORT_ENABLE && ACCEPT_THREAD_ENABLE */
+
     /* daemon got termination or interrupt signal */
     if (setjmp(restartbuf) > 0) {
 	gpsd_terminate(&context);
@@ -2201,14 +3785,16 @@ int main(int argc, char *argv[])
 
     signalled = 0;
 
+#ifdef SOCKET_EXPORT_ENABLE
+#ifdef ACCEPT_THREAD_ENABLE
+    (void)watch_fd(acceptor.wake[0], owner_acceptor, 0);
+#else
     for (i = 0; i < AFCOUNT; i++)
-	if (msocks[i] >= 0) {
-	    FD_SET(msocks[i], &all_fds);
-	    adjust_max_fd(msocks[i], true);
-	}
-#ifdef CONTROL_SOCKET_ENABLE
-    FD_ZERO(&control_fds);
-#endif /* CONTROL_SOCKET_ENABLE */
+	if (msocks[i] >= 0)
+	    (void)watch_fd(msocks[i], owner_listener, i);
+#endif /* ACCEPT_THREAD_ENABLE */
+#endif /* SOCKET_EXPORT_ENABLE */
+    (void)watch_fd(wake_pipe[0], owner_wakeup, 0);
 
     /* initialize the GPS context's time fields */
     gpsd_time_init(&context, time(NULL));
@@ -2228,87 +3814,128 @@ int main(int argc, char *argv[])
 	}
 
     while (0 == signalled) {
-	fd_set efds;
+	int nevents;
+#ifdef SOCKET_EXPORT_ENABLE
+	int nwaiting = 0, nwriting = 0;
+	static struct ready_client_t ready_clients[MAX_EVENTS];
+	static struct ready_client_t writing_clients[MAX_EVENTS];
+	static unsigned int rotor;
+	struct timespec pass_start;
+#endif /* SOCKET_EXPORT_ENABLE */
+#ifndef ACCEPT_THREAD_ENABLE
+	bool listener_ready[AFCOUNT] = {false, false};
+#endif /* ACCEPT_THREAD_ENABLE */
+#ifdef CONTROL_SOCKET_ENABLE
+	bool control_ready = false;
+#endif /* CONTROL_SOCKET_ENABLE */
 
-	switch(gpsd_await_data(&rfds, &efds, maxfd, &all_fds, &context.errout))
+	switch(await_events(events, &nevents))
 	{
 	case AWAIT_GOT_INPUT:
 	    break;
 	case AWAIT_NOT_READY:
-	    for (device = devices; device < devices + MAX_DEVICES; device++)
-		/*
-		 * The file descriptor validity check is reqiured on some ARM
-		 * platforms to prevent a core dump.  This may be due to an
-		 * implimentation error in FD_ISSET().
-		 */
+	    /* events now name descriptors that went bad under us */
+	    for (i = 0; i < nevents; i++) {
+		if (events[i].owner != owner_device)
+		    continue;
+		device = &devices[events[i].index];
 		if (allocated_device(device)
-		    && (0 <= device->gpsdata.gps_fd && device->gpsdata.gps_fd < (socket_t)FD_SETSIZE)
-		    && FD_ISSET(device->gpsdata.gps_fd, &efds)) {
+		    && device->gpsdata.gps_fd == events[i].fd) {
 		    deactivate_device(device);
 		    free_device(device);
 		}
+	    }
 	    continue;
 	case AWAIT_FAILED:
 	    exit(EXIT_FAILURE);
 	}
 
-#ifdef SOCKET_EXPORT_ENABLE
-	/* always be open to new client connections */
-	for (i = 0; i < AFCOUNT; i++) {
-	    if (msocks[i] >= 0 && FD_ISSET(msocks[i], &rfds)) {
-		socklen_t alen = (socklen_t) sizeof(fsin);
-		socket_t ssock =
-		    accept(msocks[i], (struct sockaddr *)&fsin, &alen);
-
-		if (BAD_SOCKET(ssock))
-		    gpsd_log(&context.errout, LOG_ERROR,
-			     "accept: %s\n", strerror(errno));
-		else {
-		    struct subscriber_t *client = NULL;
-		    int opts = fcntl(ssock, F_GETFL);
-		    static struct linger linger = { 1, RELEASE_TIMEOUT };
-		    char *c_ip;
+	/* route each wakeup to its owner */
+	memset(device_ready, 0, sizeof(device_ready));
+	for (i = 0; i < nevents; i++) {
+	    switch (events[i].owner) {
+#ifndef ACCEPT_THREAD_ENABLE
+	    case owner_listener:
+		listener_ready[events[i].index] = true;
+		break;
+#endif /* ACCEPT_THREAD_ENABLE */
+#ifdef CONTROL_SOCKET_ENABLE
+	    case owner_control_listener:
+		control_ready = true;
+		break;
+	    case owner_control:
+		{
+		    char buf[BUFSIZ];
+		    ssize_t rd;
+		    socket_t cfd = events[i].fd;
+
+		    /* read any commands that came in over the control socket */
+		    while ((rd = read(cfd, buf, sizeof(buf) - 1)) > 0) {
+			buf[rd] = '\0';
+			gpsd_log(&context.errout, LOG_CLIENT,
+				 "<= control(%d): %s\n", cfd, buf);
+			/* coverity[tainted_data] Safe, never handed to exec */
+			handle_control(cfd, buf);
+		    }
+		    gpsd_log(&context.errout, LOG_SPIN,
+			     "close(%d) of control socket\n", cfd);
+		    unwatch_fd(cfd);
+		    (void)close(cfd);
+		}
+		break;
+#endif /* CONTROL_SOCKET_ENABLE */
+	    case owner_wakeup:
+		{
+		    char buf[BUFSIZ];
 
-		    if (opts >= 0)
-			(void)fcntl(ssock, F_SETFL, opts | O_NONBLOCK);
+		    /*
+		     * reader hand-off slots and client output queues
+		     * are serviced below; just clear these
+		     */
+		    while (read(events[i].fd, buf, sizeof(buf)) > 0)
+			continue;
+		}
+		break;
+#ifdef ACCEPT_THREAD_ENABLE
+	    case owner_acceptor:
+		{
+		    char buf[BUFSIZ];
 
-		    c_ip = netlib_sock2ip(ssock);
-		    client = allocate_client();
-		    if (client == NULL) {
-			gpsd_log(&context.errout, LOG_ERROR,
-				 "Client %s connect on fd %d -"
-				 "no subscriber slots available\n", c_ip,
-				    ssock);
-			(void)close(ssock);
-		    } else
-			if (setsockopt
-			    (ssock, SOL_SOCKET, SO_LINGER, (char *)&linger,
-			     (int)sizeof(struct linger)) == -1) {
-			gpsd_log(&context.errout, LOG_ERROR,
-				 "Error: SETSOCKOPT SO_LINGER\n");
-			(void)close(ssock);
-		    } else {
-			char announce[GPS_JSON_RESPONSE_MAX];
-			FD_SET(ssock, &all_fds);
-			adjust_max_fd(ssock, true);
-			client->fd = ssock;
-			client->active = time(NULL);
-			gpsd_log(&context.errout, LOG_SPIN,
-				 "client %s (%d) connect on fd %d\n", c_ip,
-				 sub_index(client), ssock);
-			json_version_dump(announce, sizeof(announce));
-			(void)throttled_write(client, announce,
-					      strlen(announce));
-		    }
+		    /* the queue is drained below; just clear the wakeups */
+		    while (read(events[i].fd, buf, sizeof(buf)) > 0)
+			continue;
 		}
-		FD_CLR(msocks[i], &rfds);
+		break;
+#endif /* ACCEPT_THREAD_ENABLE */
+	    case owner_device:
+		device = &devices[events[i].index];
+		if (device->gpsdata.gps_fd == events[i].fd)
+		    device_ready[events[i].index] = true;
+		break;
+#ifdef SOCKET_EXPORT_ENABLE
+	    case owner_client:
+		sub = client_pool[events[i].index];
+		if (sub->active == 0 || sub->fd != events[i].fd)
+		    break;
+		/* devices go first; clients are served further down */
+		if (events[i].writable && nwriting < NITEMS(writing_clients)) {
+		    writing_clients[nwriting].sub = sub;
+		    writing_clients[nwriting++].fd = sub->fd;
+		}
+		if (events[i].readable && nwaiting < NITEMS(ready_clients)) {
+		    ready_clients[nwaiting].sub = sub;
+		    ready_clients[nwaiting++].fd = sub->fd;
+		}
+		break;
+#endif /* SOCKET_EXPORT_ENABLE */
+	    default:
+		break;
 	    }
 	}
-#endif /* SOCKET_EXPORT_ENABLE */
 
 #ifdef CONTROL_SOCKET_ENABLE
 	/* also be open to new control-socket connections */
-	if (csock > -1 && FD_ISSET(csock, &rfds)) {
+	if (csock > -1 && control_ready) {
 	    socklen_t alen = (socklen_t) sizeof(fsin);
 	    socket_t ssock = accept(csock, (struct sockaddr *)&fsin, &alen);
 
@@ -2319,48 +3946,34 @@ int main(int argc, char *argv[])
 		gpsd_log(&context.errout, LOG_INF,
 			 "control socket connect on fd %d\n",
 			 ssock);
-		FD_SET(ssock, &all_fds);
-		FD_SET(ssock, &control_fds);
-		adjust_max_fd(ssock, true);
+		if (!watch_fd(ssock, owner_control, 0))
+		    (void)close(ssock);
 	    }
-	    FD_CLR(csock, &rfds);
 	}
-
-	/* read any commands that came in over the control socket */
-	for (cfd = 0; cfd < (int)FD_SETSIZE; cfd++)
-	    if (FD_ISSET(cfd, &control_fds)) {
-		char buf[BUFSIZ];
-		ssize_t rd;
-
-		while ((rd = read(cfd, buf, sizeof(buf) - 1)) > 0) {
-		    buf[rd] = '\0';
-		    gpsd_log(&context.errout, LOG_CLIENT,
-			     "<= control(%d): %s\n", cfd, buf);
-		    /* coverity[tainted_data] Safe, never handed to exec */
-		    handle_control(cfd, buf);
-		}
-		gpsd_log(&context.errout, LOG_SPIN,
-			 "close(%d) of control socket\n", cfd);
-		(void)close(cfd);
-		FD_CLR(cfd, &all_fds);
-		FD_CLR(cfd, &control_fds);
-		adjust_max_fd(cfd, false);
-	    }
 #endif /* CONTROL_SOCKET_ENABLE */
 
+#ifdef READER_THREADS_ENABLE
+	/* report whatever the reader threads have decoded */
+	for (device = devices; device < devices + MAX_DEVICES; device++)
+	    if (allocated_device(device))
+		collect_reader(device);
+#else
+#ifdef IO_URING_ENABLE
+	if (uring_reads)
+	    uring_prefetch(device_ready);
+#endif /* IO_URING_ENABLE */
 	/* poll all active devices */
 	for (device = devices; device < devices + MAX_DEVICES; device++)
 	    if (allocated_device(device) && device->gpsdata.gps_fd > 0)
-		switch (gpsd_multipoll(FD_ISSET(device->gpsdata.gps_fd, &rfds),
+		switch (gpsd_multipoll(device_ready[device - devices],
 				       device, all_reports, DEVICE_REAWAKE))
 		{
 		case DEVICE_READY:
-		    FD_SET(device->gpsdata.gps_fd, &all_fds);
-		    adjust_max_fd(device->gpsdata.gps_fd, true);
+		    (void)watch_fd(device->gpsdata.gps_fd, owner_device,
+				   (int)(device - devices));
 		    break;
 		case DEVICE_UNREADY:
-		    FD_CLR(device->gpsdata.gps_fd, &all_fds);
-		    adjust_max_fd(device->gpsdata.gps_fd, false);
+		    unwatch_fd(device->gpsdata.gps_fd);
 		    break;
 		case DEVICE_ERROR:
 		case DEVICE_EOF:
@@ -2369,6 +3982,16 @@ int main(int argc, char *argv[])
 		default:
 		    break;
 		}
+#endif /* READER_THREADS_ENABLE */
+
+#ifdef SOCKET_EXPORT_ENABLE
+	/* admit new clients once the devices have been served */
+#ifdef ACCEPT_THREAD_ENABLE
+	collect_accepted();
+#else
+	accept_clients(msocks, listener_ready);
+#endif /* ACCEPT_THREAD_ENABLE */
+#endif /* SOCKET_EXPORT_ENABLE */
 
 #ifdef __UNUSED_AUTOCONNECT__
 	if (context.fixcnt > 0 && !context.autconnect) {
@@ -2385,53 +4008,94 @@ int main(int argc, char *argv[])
 #endif /* __UNUSED_AUTOCONNECT__ */
 
 #ifdef SOCKET_EXPORT_ENABLE
-	/* accept and execute commands for all clients */
-	for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++) {
-	    if (sub->active == 0)
-		continue;
+	/* client work gets what is left of the pass */
+	(void)clock_gettime(CLOCK_MONOTONIC, &pass_start);
+	rotor++;
 
-	    lock_subscriber(sub);
-	    if (FD_ISSET(sub->fd, &rfds)) {
-		char buf[BUFSIZ];
-		int buflen;
+	/* push queued output to clients that can take it */
+	for (i = 0; i < nwriting; i++) {
+	    struct ready_client_t *rc =
+		&writing_clients[(i + rotor) % nwriting];
+
+	    if (i > 0 && over_budget(&pass_start))
+		break;
+	    /* may have been dropped, or even replaced, since the wakeup */
+	    if (rc->sub->active != 0 && rc->sub->fd == rc->fd)
+		drain_client(rc->sub);
+	}
 
-		unlock_subscriber(sub);
+	/* accept and execute commands for clients with pending input */
+	for (i = 0; i < nwaiting; i++) {
+	    char buf[BUFSIZ];
+	    int buflen;
+	    struct ready_client_t *rc = &ready_clients[(i + rotor) % nwaiting];
 
-		gpsd_log(&context.errout, LOG_PROG,
-			 "checking client(%d)\n",
-			 sub_index(sub));
-		if ((buflen =
-		     (int)recv(sub->fd, buf, sizeof(buf) - 1, 0)) <= 0) {
-		    detach_client(sub);
-		} else {
-		    if (buf[buflen - 1] != '\n')
-			buf[buflen++] = '\n';
-		    buf[buflen] = '\0';
-		    gpsd_log(&context.errout, LOG_CLIENT,
-			     "<= client(%d): %s\n", sub_index(sub), buf);
+	    if (i > 0 && over_budget(&pass_start))
+		break;
+	    sub = rc->sub;
+	    /* may have been dropped while reporting device data */
+	    if (sub->active == 0 || sub->fd != rc->fd)
+		continue;
 
-		    /*
-		     * When a command comes in, update subscriber.active to
-		     * timestamp() so we don't close the connection
-		     * after COMMAND_TIMEOUT seconds. This makes
-		     * COMMAND_TIMEOUT useful.
-		     */
-		    sub->active = time(NULL);
-		    if (handle_gpsd_request(sub, buf) < 0)
-			detach_client(sub);
-		}
+	    gpsd_log(&context.errout, LOG_PROG,
+		     "checking client(%d)\n",
+		     sub_index(sub));
+	    if ((buflen =
+		 (int)recv(sub->fd, buf, sizeof(buf) - 1, 0)) <= 0) {
+		detach_client(sub);
 	    } else {
-		unlock_subscriber(sub);
+		if (buf[buflen - 1] != '\n')
+		    buf[buflen++] = '\n';
+		buf[buflen] = '\0';
+		gpsd_log(&context.errout, LOG_CLIENT,
+			 "<= client(%d): %s\n", sub_index(sub), buf);
 
-		if (!sub->policy.watcher
-		    && time(NULL) - sub->active > COMMAND_TIMEOUT) {
-		    gpsd_log(&context.errout, LOG_WARN,
-			     "client(%d) timed out on command wait.\n",
-			     sub_index(sub));
+		/*
+		 * When a command comes in, update subscriber.active to
+		 * timestamp() so we don't close the connection
+		 * after COMMAND_TIMEOUT seconds. This makes
+		 * COMMAND_TIMEOUT useful.
+		 */
+		sub->active = time(NULL);
+#ifdef READER_THREADS_ENABLE
+		lock_readers();
+#endif /* READER_THREADS_ENABLE */
+		if (handle_gpsd_request(sub, buf) < 0)
 		    detach_client(sub);
-		}
+#ifdef READER_THREADS_ENABLE
+		unlock_readers();
+#endif /* READER_THREADS_ENABLE */
+	    }
+	}
+
+	/*
+	 * Drop clients that connected but never asked for anything,
+	 * and clients whose queued output hasn't drained at all for
+	 * NOREAD_TIMEOUT seconds.
+	 */
+	lock_clients();
+	for (i = nclients - 1; i >= 0; i--) {
+	    sub = active_clients[i];
+	    if (sub->active == 0)
+		continue;
+
+	    if (sub->outq_count > 0
+		&& time(NULL) - sub->outq_moved > NOREAD_TIMEOUT) {
+		gpsd_log(&context.errout, LOG_INF,
+			 "client(%d) timed out.\n", sub_index(sub));
+		detach_client(sub);
+		continue;
+	    }
+
+	    if (!sub->policy.watcher
+		&& time(NULL) - sub->active > COMMAND_TIMEOUT) {
+		gpsd_log(&context.errout, LOG_WARN,
+			 "client(%d) timed out on command wait.\n",
+			 sub_index(sub));
+		detach_client(sub);
 	    }
 	}
+	unlock_clients();
 
 	/*
 	 * Mark devices with an identified packet type but no
@@ -2444,39 +4108,58 @@ int main(int argc, char *argv[])
 	for (device = devices; device < devices + MAX_DEVICES; device++) {
 
 	    bool device_needed = NOWAIT;
+	    socket_t gps_fd;
+	    int packet_type;
 
 	    if (!allocated_device(device))
 		continue;
 
-	    if (!device_needed)
-		for (sub=subscribers; sub<subscribers+MAX_CLIENTS; sub++) {
+	    if (!device_needed) {
+		struct watcher_list_t *wl =
+		    &device_watchers[device - devices];
+		lock_clients();
+		for (i = 0; i < wl->count; i++) {
+		    sub = wl->subs[i];
 		    if (sub->active == 0)
 			continue;
 		    device_needed = subscribed(sub, device);
 		    if (device_needed)
 			break;
 		}
+		unlock_clients();
+	    }
 
-	    if (!device_needed && device->gpsdata.gps_fd > -1 &&
-		    device->lexer.type != BAD_PACKET) {
+	    /*
+	     * A running reader retypes the lexer on every packet and may
+	     * close the device, so sample both under its lock.  The lock
+	     * must be dropped before deactivate_device() joins the reader.
+	     */
+#ifdef READER_THREADS_ENABLE
+	    (void)pthread_mutex_lock(&readers[device - devices].lock);
+#endif /* READER_THREADS_ENABLE */
+	    gps_fd = device->gpsdata.gps_fd;
+	    packet_type = device->lexer.type;
+#ifdef READER_THREADS_ENABLE
+	    (void)pthread_mutex_unlock(&readers[device - devices].lock);
+#endif /* READER_THREADS_ENABLE */
+
+	    if (!device_needed && gps_fd > -1 && packet_type != BAD_PACKET) {
 		if (device->releasetime == 0) {
 		    device->releasetime = time(NULL);
 		    gpsd_log(&context.errout, LOG_PROG,
 			     "device %d (fd %d) released\n",
-			     (int)(device - devices),
-			     device->gpsdata.gps_fd);
+			     (int)(device - devices), gps_fd);
 		} else if (time(NULL) - device->releasetime > RELEASE_TIMEOUT) {
 		    gpsd_log(&context.errout, LOG_PROG,
 			     "device %d closed\n",
 			     (int)(device - devices));
 		    gpsd_log(&context.errout, LOG_RAW,
-			     "unflagging descriptor %d\n",
-			     device->gpsdata.gps_fd);
+			     "unflagging descriptor %d\n", gps_fd);
 		    deactivate_device(device);
 		}
 	    }
 
-	    if (device_needed && BAD_SOCKET(device->gpsdata.gps_fd) &&
+	    if (device_needed && BAD_SOCKET(gps_fd) &&
 		    (device->opentime == 0 ||
 		    time(NULL) - device->opentime > DEVICE_RECONNECT)) {
 		device->opentime = time(NULL);
@@ -2502,9 +4185,11 @@ int main(int argc, char *argv[])
 	if (argc == optind && highwater > 0) {
 	    int subcount = 0, devcount = 0;
 #ifdef SOCKET_EXPORT_ENABLE
-	    for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++)
-		if (sub->active != 0)
+	    lock_clients();
+	    for (i = 0; i < nclients; i++)
+		if (active_clients[i]->active != 0)
 		    ++subcount;
+	    unlock_clients();
 #endif /* SOCKET_EXPORT_ENABLE */
 	    for (device = devices; device < devices + MAX_DEVICES; device++)
 		if (allocated_device(device))
@@ -2536,16 +4221,23 @@ shutdown:
      * This is an attempt to avoid the sporadic race errors at the ends
      * of our regression tests.
      */
-    for (sub = subscribers; sub < subscribers + MAX_CLIENTS; sub++) {
+    lock_clients();
+    for (i = nclients - 1; i >= 0; i--) {
+	sub = active_clients[i];
 	if (sub->active != 0)
 	    detach_client(sub);
     }
+    unlock_clients();
 #endif /* SOCKET_EXPORT_ENABLE */
 
 #ifdef SHM_EXPORT_ENABLE
     shm_release(&context);
 #endif /* SHM_EXPORT_ENABLE */
 
+#ifdef IO_URING_ENABLE
+    uring_wrap();
+#endif /* IO_URING_ENABLE */
+
 #ifdef CONTROL_SOCKET_ENABLE
     if (control_socket)
 	(void)unlink(control_socket);
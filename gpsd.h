@@ -24,6 +24,9 @@ extern "C" {
 #ifdef HAVE_WINSOCK2_H
 #include <winsock2.h> /* for fd_set */
 #endif
+#ifdef EPOLL_ENABLE
+#include <sys/epoll.h>
+#endif /* EPOLL_ENABLE */
 #include <time.h>    /* for time_t */
 
 #include "gps.h"
@@ -52,10 +55,12 @@ extern "C" {
  * 3.12 OSC message added to repertoire.
  * 3.13 gnssid:svid added to SAT
  *      time added to ATT
+ * 3.14 RAW message added to repertoire.
+ * 3.15 protocols added to DEVICE
  */
 /* Keep in sync with api_major_version and api_minor gps/__init__.py */
 #define GPSD_PROTO_MAJOR_VERSION	3   /* bump on incompatible changes */
-#define GPSD_PROTO_MINOR_VERSION	13  /* bump on compatible changes */
+#define GPSD_PROTO_MINOR_VERSION	15  /* bump on compatible changes */
 
 #define JSON_DATE_MAX	24	/* ISO8601 timestamp with 2 decimal places */
 
@@ -137,6 +142,27 @@ enum isgpsstat_t {
  */
 #define MAX_PACKET_LENGTH	516	/* 7 + 506 + 3 */
 
+/*
+ * Longest length-framed packet the lexer will wait for.  These types
+ * are parsed in place (see ZEROCOPY_TYPEMASK) so only the input store
+ * has to hold one.  A UBX RXM-RAWX with 255 measurements is 8184
+ * bytes; a GREIS message is at most 4100, an RTCM3 one 1029.
+ */
+#define MAX_FRAME_LENGTH	8192
+
+/*
+ * Size of the lexer's input store.  Reads go in after the unconsumed
+ * input and packets are taken off the front by moving a window, so a
+ * large store means fewer, bigger reads and only an occasional copy.
+ * It has to hold at least two maximum-length frames.
+ */
+#ifndef LEXER_BUFSIZE
+#define LEXER_BUFSIZE	(MAX_FRAME_LENGTH*2)
+#endif /* LEXER_BUFSIZE */
+#if LEXER_BUFSIZE < MAX_FRAME_LENGTH*2
+#error LEXER_BUFSIZE is too small
+#endif
+
 /*
  * UTC of second 0 of week 0 of the first rollover period of GPS time.
  * Used to compute UTC from GPS time. Also, the threshold value
@@ -192,17 +218,42 @@ struct gps_lexer_t {
 #define LOSSLESS_PACKET_TYPE(n)	(((n)>=RTCM2_PACKET) && ((n)<=RTCM3_PACKET))
 #define PACKET_TYPEMASK(n)	(1 << (n))
 #define GPS_TYPEMASK	(((2<<(MAX_GPSPACKET_TYPE+1))-1) &~ PACKET_TYPEMASK(COMMENT_PACKET))
+/* binary packets whose drivers parse straight from the lexer's frame */
+#define ZEROCOPY_TYPEMASK	(PACKET_TYPEMASK(UBX_PACKET) \
+				 | PACKET_TYPEMASK(GREIS_PACKET) \
+				 | PACKET_TYPEMASK(RTCM3_PACKET))
     unsigned int state;
     size_t length;
-    unsigned char inbuffer[MAX_PACKET_LENGTH*2+1];
+    unsigned char *inbuffer;		/* window start, in inbufstore */
     size_t inbuflen;
+    size_t prefetched;			/* read in by the daemon, not counted */
     unsigned char *inbufptr;
+    unsigned char inbufstore[LEXER_BUFSIZE];
+    /*
+     * Packet types the lexer is hunting for, 0 for all of them, and
+     * the bytes that can start one; see packet_typemask().
+     */
+    unsigned int typemask;
+    unsigned char leaders[32];
+    size_t nleaders;
+    /* leaders of unwanted types skipped since the hunt was set */
+    unsigned long missed_leaders;
+    /*
+     * The packet just accepted, read-only and good until the next
+     * packet_get().  Only types outside ZEROCOPY_TYPEMASK are also
+     * copied to outbuffer (and NUL-terminated there), for the parsers
+     * that edit a packet in place or treat it as a string.  outbuflen
+     * is the packet length either way.
+     */
+    const unsigned char *frame;
     /* outbuffer needs to be able to hold 4 GPGSV records at once */
     unsigned char outbuffer[MAX_PACKET_LENGTH*2+1];
     size_t outbuflen;
     unsigned long char_counter;		/* count characters processed */
     unsigned long retry_counter;	/* count sniff retries */
     unsigned counter;			/* packets since last driver switch */
+    unsigned long long_frames;		/* packets too long for outbuffer */
+    unsigned long overruns;		/* packets in progress given up on */
     struct gpsd_errout_t errout;		/* how to report errors */
 #ifdef TIMING_ENABLE
     timestamp_t start_time;		/* timestamp of first input */
@@ -237,12 +288,29 @@ struct gps_lexer_t {
 #endif /* STASH_ENABLE */
 };
 
+/*
+ * A complete packet as returned by packet_frames(), normally still
+ * sitting in the lexer's input store.  It stays put until the lexer
+ * is next asked for packets, so a burst can be handled in one go.
+ */
+struct gps_frame_t {
+    int type;				/* packet type, as in the lexer */
+    const unsigned char *data;
+    size_t len;
+};
+
 extern void lexer_init(struct gps_lexer_t *);
 extern void packet_reset(struct gps_lexer_t *);
+extern void packet_typemask(struct gps_lexer_t *, unsigned int);
 extern void packet_pushback(struct gps_lexer_t *);
 extern void packet_parse(struct gps_lexer_t *);
 extern ssize_t packet_get(int, struct gps_lexer_t *);
+extern size_t packet_space(struct gps_lexer_t *);
+extern size_t packet_frames(struct gps_lexer_t *,
+			    struct gps_frame_t *, size_t);
 extern int packet_sniff(struct gps_lexer_t *);
+extern void ubx_checksum(const unsigned char *, size_t,
+			 unsigned char *, unsigned char *);
 #define packet_buffered_input(lexer) ((lexer)->inbuffer + (lexer)->inbuflen - (lexer)->inbufptr)
 
 /* Next, declarations for the core library... */
@@ -270,6 +338,7 @@ struct gps_context_t {
 #define CENTURY_VALID		0x04	/* have received ZDA or 4-digit year */
     struct gpsd_errout_t errout;		/* debug verbosity level and hook */
     bool readonly;			/* if true, never write to device */
+    bool settle_lexer;			/* narrow lexer hunt once synced */
     /* DGPS status */
     int fixcnt;				/* count of good fixes seen */
     /* timekeeping */
@@ -539,6 +608,10 @@ struct gps_device_t {
     char msgbuf[MAX_PACKET_LENGTH*4+1];	/* command message buffer for sends */
     size_t msgbuflen;
     int observed;			/* which packet type`s have we seen? */
+    unsigned int pinned_types;		/* lexer typemask set by ?DEVICE */
+#define PINNED_ALL	(~0U)		/* "ALL": every type, never settle */
+    unsigned int settle_count;		/* packets since lexer last widened */
+    unsigned long settle_chars;		/* char_counter at last packet */
     bool cycle_end_reliable;		/* does driver signal REPORT_MASK */
     int fixcnt;				/* count of fixes from this device */
     struct gps_fix_t newdata;		/* where drivers put their data */
@@ -817,7 +890,7 @@ extern void rtcm2_unpack(struct rtcm2_t *, char *);
 extern void json_rtcm3_dump(const struct rtcm3_t *,
 			    const char *, char[], size_t);
 extern void rtcm3_unpack(const struct gps_context_t *,
-			 struct rtcm3_t *, char *);
+			 struct rtcm3_t *, const char *);
 
 /* here are the available GPS drivers */
 extern const struct gps_type_t **gpsd_drivers;
@@ -863,6 +936,7 @@ extern ssize_t gpsd_serial_write(struct gps_device_t *,
 				 const char *, const size_t);
 extern bool gpsd_next_hunt_setting(struct gps_device_t *);
 extern int gpsd_switch_driver(struct gps_device_t *, char *);
+extern void gpsd_lexer_unsettle(struct gps_device_t *);
 #ifdef HAVE_TERMIOS_H
 extern void gpsd_set_speed(struct gps_device_t *, speed_t, char, unsigned int);
 extern speed_t gpsd_get_speed(const struct gps_device_t *);
@@ -887,8 +961,8 @@ extern gps_mask_t gpsd_interpret_subframe(struct gps_device_t *, unsigned int,
 				uint32_t[]);
 extern gps_mask_t gpsd_interpret_subframe_raw(struct gps_device_t *,
 				unsigned int, uint32_t[]);
-extern const char *gpsd_hexdump(char *, size_t, char *, size_t);
-extern const char *gpsd_packetdump(char *, size_t, char *, size_t);
+extern const char *gpsd_hexdump(char *, size_t, const char *, size_t);
+extern const char *gpsd_packetdump(char *, size_t, const char *, size_t);
 extern const char *gpsd_prettydump(struct gps_device_t *);
 # ifdef __cplusplus
 extern "C" {
@@ -946,6 +1020,19 @@ extern bool shm_acquire(struct gps_context_t *);
 extern void shm_release(struct gps_context_t *);
 extern void shm_update(struct gps_context_t *, struct gps_data_t *);
 
+/* uring.c */
+#ifdef IO_URING_ENABLE
+struct iovec;
+struct io_uring_sqe;
+struct io_uring_cqe;
+extern bool uring_init(unsigned, const struct gpsd_errout_t *);
+extern void uring_wrap(void);
+extern bool uring_register_buffers(const struct iovec *, unsigned);
+extern struct io_uring_sqe *uring_get_sqe(void);
+extern int uring_submit(unsigned);
+extern bool uring_reap(struct io_uring_cqe *);
+#endif /* IO_URING_ENABLE */
+
 /* dbusexport.c */
 #if defined(DBUS_EXPORT_ENABLE)
 int initialize_dbus_connection (void);
@@ -986,6 +1073,16 @@ extern int gpsd_await_data(fd_set *,
 			    const int,
 			    fd_set *,
 			    struct gpsd_errout_t *errout);
+extern int gpsd_await_io(fd_set *, fd_set *, fd_set *,
+			 const int,
+			 fd_set *, fd_set *,
+			 struct gpsd_errout_t *errout);
+#ifdef EPOLL_ENABLE
+extern int gpsd_await_events(int,
+			     struct epoll_event *,
+			     int, int *,
+			     struct gpsd_errout_t *errout);
+#endif /* EPOLL_ENABLE */
 extern gps_mask_t gpsd_poll(struct gps_device_t *);
 #define DEVICE_EOF	-3
 #define DEVICE_ERROR	-2
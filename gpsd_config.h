@@ -62,6 +62,9 @@
 
 #define HAVE_FORK 1
 
+/* accept client connections on a thread of their own in gpsd */
+/* #undef ACCEPT_THREAD_ENABLE */
+
 /* AIVDM support */
 #define AIVDM_ENABLE 1
 
@@ -98,6 +101,9 @@
 /* DeLorme EarthMate Zodiac support */
 #define EARTHMATE_ENABLE 1
 
+/* use epoll(7) rather than pselect(2) in gpsd */
+#define EPOLL_ENABLE 1
+
 /* EverMore binary support */
 #define EVERMORE_ENABLE 1
 
@@ -149,6 +155,9 @@
 /* header file directory */
 #define INCLUDEDIR "include"
 
+/* batch gpsd device reads and client writes with io_uring(7) */
+/* #undef IO_URING_ENABLE */
+
 /* build IPv6 support */
 #define IPV6_ENABLE 1
 
@@ -161,6 +170,9 @@
 /* fetch up-to-date data on leap seconds. */
 #define LEAPFETCH_ENABLE 1
 
+/* size of each device's input buffer */
+#define LEXER_BUFSIZE 32768
+
 /* system libraries */
 #define LIBDIR "lib"
 
@@ -176,7 +188,7 @@
 /* manual pages directory */
 #define MANDIR "share/man"
 
-/* maximum allowed clients */
+/* initial size of the client table */
 #define MAX_CLIENTS 64
 
 /* maximum allowed devices */
@@ -257,6 +269,9 @@
 /* version for versioned Qt */
 /* #undef QT_VERSIONED */
 
+/* decode each device on its own thread in gpsd */
+/* #undef READER_THREADS_ENABLE */
+
 /* allow gpsd to change device settings */
 #define RECONFIGURE_ENABLE 1
 
@@ -68,6 +68,32 @@ struct classmap_t classmap[CLASSMAP_NITEMS] = {
     {"RTCM3",	SEEN_RTCM3,	PACKET_TYPEMASK(RTCM3_PACKET)},
     {"AIS",	SEEN_AIS,  	PACKET_TYPEMASK(AIVDM_PACKET)},
 };
+
+/* names for the packet types a device can be held to by ?DEVICE */
+static const struct protocolmap_t {
+    char	*name;
+    int		packettype;
+} protocolmap[] = {
+    {"NMEA",		NMEA_PACKET},
+    {"AIVDM",		AIVDM_PACKET},
+    {"GARMINTXT",	GARMINTXT_PACKET},
+    {"SIRF",		SIRF_PACKET},
+    {"ZODIAC",		ZODIAC_PACKET},
+    {"TSIP",		TSIP_PACKET},
+    {"EVERMORE",	EVERMORE_PACKET},
+    {"ITALK",		ITALK_PACKET},
+    {"GARMIN",		GARMIN_PACKET},
+    {"NAVCOM",		NAVCOM_PACKET},
+    {"UBX",		UBX_PACKET},
+    {"SUPERSTAR2",	SUPERSTAR2_PACKET},
+    {"ONCORE",		ONCORE_PACKET},
+    {"GEOSTAR",		GEOSTAR_PACKET},
+    {"GREIS",		GREIS_PACKET},
+    {"RTCM2",		RTCM2_PACKET},
+    {"RTCM3",		RTCM3_PACKET},
+    {"JSON",		JSON_PACKET},
+    {"SKYTRAQ",		SKY_PACKET},
+};
 /* *INDENT-ON* */
 
 char *json_stringify( char *to,
@@ -353,6 +379,76 @@ void json_sky_dump(const struct gps_data_t *datap,
     (void)strlcat(reply, "}\r\n", replylen);
 }
 
+int json_raw_dump(const struct gps_data_t *datap,
+		  char *reply, size_t replylen)
+/* dump a raw measurement record as JSON, return the entries dumped */
+{
+    const struct rawmeas_t *raw = &datap->rawmeas;
+    /* room for the closing "],\"nmeas\":NNN}\r\n" and NUL */
+    const size_t tail = 20;
+    char entry[GPS_JSON_RAW_ENTRY_MAX];
+    size_t len;
+    int i, n;
+
+    assert(replylen > tail);
+    /* libgps won't take a longer line than this */
+    if (replylen > GPS_JSON_RAW_MAX)
+	replylen = GPS_JSON_RAW_MAX;
+    (void)snprintf(reply, replylen - tail,
+		   "{\"class\":\"RAW\",\"device\":\"%s\",", datap->dev.path);
+    if (isfinite(raw->mtime) != 0) {
+	char tbuf[JSON_DATE_MAX+1];
+	str_appendf(reply, replylen - tail, "\"time\":\"%s\",",
+		    unix_to_iso8601(raw->mtime, tbuf, sizeof(tbuf)));
+    }
+    (void)strlcat(reply, "\"rawdata\":[", replylen - tail);
+
+    /*
+     * At 10Hz with a full multi-GNSS tracking list this is the largest
+     * report the daemon makes, so keep a running length instead of
+     * rescanning the buffer for every measurement.  GPS_JSON_RAW_MAX
+     * has room for all of them; if the caller's buffer is smaller, an
+     * entry that doesn't fit is dropped whole so the object stays
+     * well-formed, and "nmeas" tells the client how many there were.
+     */
+    len = strlen(reply);
+    for (i = 0; i < raw->nmeas && i < MAXCHANNELS; i++) {
+	const struct meas_t *meas = &raw->meas[i];
+
+	n = snprintf(entry, sizeof(entry),
+		     "{\"gnssid\":%u,\"svid\":%u,\"sigid\":%u,"
+		     "\"snr\":%u,\"locktime\":%u",
+		     meas->gnssid, meas->svid, meas->sigid,
+		     meas->snr, meas->locktime);
+	/* only GLONASS has frequency slots */
+	if (meas->gnssid == 6)
+	    n += snprintf(entry + n, sizeof(entry) - n,
+			  ",\"freqid\":%u", meas->freqid);
+	if (isfinite(meas->pseudorange) != 0)
+	    n += snprintf(entry + n, sizeof(entry) - n,
+			  ",\"pseudorange\":%.12g", meas->pseudorange);
+	if (isfinite(meas->carrierphase) != 0)
+	    n += snprintf(entry + n, sizeof(entry) - n,
+			  ",\"carrierphase\":%.12g", meas->carrierphase);
+	if (isfinite(meas->doppler) != 0)
+	    n += snprintf(entry + n, sizeof(entry) - n,
+			  ",\"doppler\":%.12g", meas->doppler);
+	n += snprintf(entry + n, sizeof(entry) - n, "},");
+	if (len + (size_t)n >= replylen - tail)
+	    break;
+	memcpy(reply + len, entry, (size_t)n + 1);
+	len += (size_t)n;
+    }
+    if (reply[len - 1] == ',')
+	reply[--len] = '\0';
+    if (i < raw->nmeas)
+	(void)snprintf(reply + len, replylen - len,
+		       "],\"nmeas\":%d}\r\n", raw->nmeas);
+    else
+	(void)strlcpy(reply + len, "]}\r\n", replylen - len);
+    return i;
+}
+
 void json_device_dump(const struct gps_device_t *device,
 		      char *reply, size_t replylen)
 {
@@ -410,10 +506,48 @@ void json_device_dump(const struct gps_device_t *device,
 #endif /* RECONFIGURE_ENABLE */
 	}
     }
+    if (device->pinned_types == PINNED_ALL)
+	(void)strlcat(reply, "\"protocols\":\"ALL\",", replylen);
+    else if (device->pinned_types != 0) {
+	const struct protocolmap_t *pmp;
+	(void)strlcat(reply, "\"protocols\":\"", replylen);
+	for (pmp = protocolmap; pmp < protocolmap + NITEMS(protocolmap); pmp++)
+	    if ((device->pinned_types & PACKET_TYPEMASK(pmp->packettype)) != 0)
+		str_appendf(reply, replylen, "%s,", pmp->name);
+	str_rstrip_char(reply, ',');
+	(void)strlcat(reply, "\",", replylen);
+    }
     str_rstrip_char(reply, ',');
     (void)strlcat(reply, "}\r\n", replylen);
 }
 
+int json_protocols_read(const char *names, unsigned int *types)
+/* turn a comma-separated list of packet type names into a typemask */
+{
+    const char *sp = names;
+
+    *types = 0;
+    if (strcmp(names, "ALL") == 0) {
+	*types = PINNED_ALL;
+	return 0;
+    }
+    while (*sp != '\0') {
+	const struct protocolmap_t *pmp;
+	size_t len = strcspn(sp, ",");
+
+	for (pmp = protocolmap; pmp < protocolmap + NITEMS(protocolmap); pmp++)
+	    if (strlen(pmp->name) == len && strncmp(pmp->name, sp, len) == 0)
+		break;
+	if (pmp == protocolmap + NITEMS(protocolmap))
+	    return -1;
+	*types |= PACKET_TYPEMASK(pmp->packettype);
+	sp += len;
+	if (*sp == ',')
+	    sp++;
+    }
+    return 0;
+}
+
 void json_watch_dump(const struct gps_policy_t *ccp,
 		     char *reply, size_t replylen)
 {
@@ -3466,6 +3600,15 @@ void json_data_report(const gps_mask_t changed,
 	json_subframe_dump(datap, buf+strlen(buf), buflen-strlen(buf));
     }
 
+    if ((changed & RAW_SET) != 0) {
+	int dumped = json_raw_dump(datap, buf+strlen(buf), buflen-strlen(buf));
+
+	if (dumped < datap->rawmeas.nmeas)
+	    gpsd_log(&session->context->errout, LOG_WARN,
+		     "RAW report cut to %d of %d measurements\n",
+		     dumped, datap->rawmeas.nmeas);
+    }
+
 #ifdef COMPASS_ENABLE
     if ((changed & ATTITUDE_SET) != 0) {
 	json_att_dump(datap, buf+strlen(buf), buflen-strlen(buf));
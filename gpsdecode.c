@@ -554,7 +554,7 @@ static void decode(FILE *fpin, FILE*fpout)
     struct gps_policy_t policy;
     size_t minima[PACKET_TYPES+1];
 #if defined(SOCKET_EXPORT_ENABLE) || defined(AIVDM_ENABLE)
-    char buf[GPS_JSON_RESPONSE_MAX * 4];
+    char buf[GPS_JSON_RESPONSE_MAX * 4 + GPS_JSON_RAW_MAX];
 #endif
     int i;
 
@@ -590,7 +590,7 @@ static void decode(FILE *fpin, FILE*fpout)
 	if (session.lexer.outbuflen < minima[session.lexer.type+1])
 	    minima[session.lexer.type+1] = session.lexer.outbuflen;
 	/* mask should match what's in report_data() */
-	if ((changed & (REPORT_IS|GST_SET|SATELLITE_SET|SUBFRAME_SET|ATTITUDE_SET|RTCM2_SET|RTCM3_SET|AIS_SET|PASSTHROUGH_IS)) == 0)
+	if ((changed & (REPORT_IS|GST_SET|SATELLITE_SET|SUBFRAME_SET|RAW_SET|ATTITUDE_SET|RTCM2_SET|RTCM3_SET|AIS_SET|PASSTHROUGH_IS)) == 0)
 	    continue;
 	if (!filter(changed, &session))
 	    continue;
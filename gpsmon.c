@@ -741,7 +741,8 @@ static void gpsmon_hook(struct gps_device_t *device, gps_mask_t changed UNUSED)
 
 /* FIXME:  If the following condition is false, the display is screwed up. */
 #if defined(SOCKET_EXPORT_ENABLE) && defined(PPS_DISPLAY_ENABLE)
-    if (!serial && str_starts_with((char*)device->lexer.outbuffer, "{\"class\":\"TOFF\",")) {
+    if (!serial && device->lexer.type == JSON_PACKET
+	&& str_starts_with((char*)device->lexer.outbuffer, "{\"class\":\"TOFF\",")) {
 	const char *end = NULL;
 	int status = json_toff_read((const char *)device->lexer.outbuffer,
 				   &session.gpsdata,
@@ -762,7 +763,8 @@ static void gpsmon_hook(struct gps_device_t *device, gps_mask_t changed UNUSED)
 #endif /* NTP_ENABLE */
 	    return;
 	}
-    } else if (!serial && str_starts_with((char*)device->lexer.outbuffer, "{\"class\":\"PPS\",")) {
+    } else if (!serial && device->lexer.type == JSON_PACKET
+	&& str_starts_with((char*)device->lexer.outbuffer, "{\"class\":\"PPS\",")) {
 	const char *end = NULL;
 	struct gps_data_t noclobber;
 	int status = json_pps_read((const char *)device->lexer.outbuffer,
@@ -830,7 +832,7 @@ static void gpsmon_hook(struct gps_device_t *device, gps_mask_t changed UNUSED)
 	(void)snprintf(buf, sizeof(buf), "(%d) ",
 		       (int)device->lexer.outbuflen);
 	cond_hexdump(buf + strlen(buf), sizeof(buf) - strlen(buf),
-		     (char *)device->lexer.outbuffer,device->lexer.outbuflen);
+		     (const char *)device->lexer.frame,device->lexer.outbuflen);
 	(void)strlcat(buf, "\n", sizeof(buf));
     }
 
@@ -848,7 +850,7 @@ static void gpsmon_hook(struct gps_device_t *device, gps_mask_t changed UNUSED)
 
     if (logfile != NULL && device->lexer.outbuflen > 0) {
         UNUSED size_t written_count = fwrite
-               (device->lexer.outbuffer, sizeof(char),
+               (device->lexer.frame, sizeof(char),
                 device->lexer.outbuflen, logfile);
         assert(written_count >= 1);
     }
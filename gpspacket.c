@@ -74,7 +74,7 @@ newLexerObject(PyObject *arg UNUSED)
     if (self == NULL)
 	return NULL;
     memset(&self->lexer, 0, sizeof(struct gps_lexer_t));
-    packet_reset(&self->lexer);
+    lexer_init(&self->lexer);
     return self;
 }
 
@@ -103,7 +103,7 @@ Lexer_get(LexerObject *self, PyObject *args)
     return Py_BuildValue("(i, i, " GPSD_PY_BYTE_FORMAT ", i)",
 			 len,
 			 self->lexer.type,
-			 self->lexer.outbuffer,
+			 self->lexer.frame,
 			 self->lexer.outbuflen,
 			 self->lexer.char_counter);
 }
@@ -11,6 +11,7 @@
 #define _XOPEN_SOURCE 600
 
 #include <stdio.h>
+#include <stddef.h>
 #include <time.h>
 #include <sys/time.h>
 #include <stdlib.h>
@@ -342,6 +343,31 @@ void gps_merge_fix(struct gps_fix_t *to,
     }
 }
 
+void gps_data_copy(struct gps_data_t *to, const struct gps_data_t *from)
+/* copy a report, leaving out the unused tail of a raw measurement record */
+{
+    size_t len = sizeof(struct gps_data_t);
+
+    /*
+     * A RAW report lives in the union, which is sized for the legacy
+     * rawdata_t; with a handful of satellites tracked most of it is
+     * dead weight.  privdata sits after the union, so carry it over
+     * by hand.
+     */
+    if ((from->set & UNION_SET) == RAW_SET) {
+	int nmeas = from->rawmeas.nmeas;
+
+	if (nmeas < 0)
+	    nmeas = 0;
+	else if (nmeas > MAXCHANNELS)
+	    nmeas = MAXCHANNELS;
+	len = offsetof(struct gps_data_t, rawmeas.meas)
+	    + (size_t)nmeas * sizeof(struct meas_t);
+	to->privdata = from->privdata;
+    }
+    (void)memcpy(to, from, len);
+}
+
 /* NOTE: timestamp_t is a double, so this is only precise to
  * near microSec.  Do not use near PPS which is nanoSec precise */
 timestamp_t timestamp(void)
@@ -23,9 +23,9 @@
  */
 
 const char *gpsd_packetdump(char *scbuf, size_t scbuflen,
-			    char *binbuf, size_t binbuflen)
+			    const char *binbuf, size_t binbuflen)
 {
-    char *cp;
+    const char *cp;
     bool printable = true;
 
     assert(binbuf != NULL);
@@ -34,14 +34,19 @@ const char *gpsd_packetdump(char *scbuf, size_t scbuflen,
 	    printable = false;
 	    break;	/* no need to keep iterating */
         }
-    if (printable)
-	return binbuf;
-    else
+    if (printable) {
+	/* binbuf may be a span of a bigger buffer, not a string */
+	size_t len = binbuflen < scbuflen ? binbuflen : scbuflen - 1;
+
+	memcpy(scbuf, binbuf, len);
+	scbuf[len] = '\0';
+	return scbuf;
+    } else
 	return gpsd_hexdump(scbuf, scbuflen, binbuf, binbuflen);
 }
 
 const char *gpsd_hexdump(char *scbuf, size_t scbuflen,
-					  char *binbuf, size_t binbuflen)
+					  const char *binbuf, size_t binbuflen)
 {
 #ifndef SQUELCH_ENABLE
     size_t i, j = 0;
@@ -132,6 +132,9 @@ static char *json_target_address(const struct json_attr_t *cursor,
 	case t_ushort:
 	    targetaddr = (char *)&cursor->addr.ushortint[offset];
 	    break;
+	case t_ubyte:
+	    targetaddr = (char *)&cursor->addr.ubyte[offset];
+	    break;
 	case t_time:
 	case t_real:
 	    targetaddr = (char *)&cursor->addr.real[offset];
@@ -208,6 +211,9 @@ static int json_internal_read_object(const char *cp,
 		    memcpy(lptr, &cursor->dflt.ushortint,
 		           sizeof(unsigned short));
 		    break;
+		case t_ubyte:
+		    lptr[0] = (char)cursor->dflt.ubyte;
+		    break;
 		case t_time:
 		case t_real:
 		    memcpy(lptr, &cursor->dflt.real, sizeof(double));
@@ -506,6 +512,12 @@ static int json_internal_read_object(const char *cp,
 			memcpy(lptr, &tmp, sizeof(unsigned short));
 		    }
 		    break;
+		case t_ubyte:
+		    {
+			unsigned char tmp = (unsigned char)atoi(valbuf);
+			memcpy(lptr, &tmp, sizeof(unsigned char));
+		    }
+		    break;
 		case t_time:
 		    {
 			double tmp = iso8601_to_unix(valbuf);
@@ -713,6 +725,7 @@ int json_read_array(const char *cp, const struct json_array_t *arr,
 	    }
 	    break;
 	case t_character:
+	case t_ubyte:
 	case t_array:
 	case t_check:
 	case t_ignore:
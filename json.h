@@ -12,7 +12,7 @@ typedef enum {t_integer, t_uinteger, t_real,
 	      t_time,
 	      t_object, t_structobject, t_array,
 	      t_check, t_ignore,
-	      t_short, t_ushort}
+	      t_short, t_ushort, t_ubyte}
     json_type;
 
 struct json_enum_t {
@@ -63,6 +63,7 @@ struct json_attr_t {
 	unsigned int *uinteger;
 	short *shortint;
 	unsigned short *ushortint;
+	unsigned char *ubyte;
 	double *real;
 	char *string;
 	bool *boolean;
@@ -75,6 +76,7 @@ struct json_attr_t {
 	unsigned int uinteger;
 	short shortint;
 	unsigned short ushortint;
+	unsigned char ubyte;
 	double real;
 	bool boolean;
 	char character;
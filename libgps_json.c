@@ -282,6 +282,7 @@ static int json_devicelist_read(const char *buf, struct gps_data_t *gpsdata,
 				        .dflt.real = NAN},
 	{"mincycle",   t_real,       STRUCTOBJECT(struct devconfig_t, mincycle),
 				        .dflt.real = NAN},
+	{"protocols",  t_ignore},	/* daemon-side only */
 	{NULL},
 	/* *INDENT-ON* */
     };
@@ -458,6 +459,59 @@ int json_oscillator_read(const char *buf, struct gps_data_t *gpsdata,
     return status;
 }
 
+static int json_raw_read(const char *buf, struct gps_data_t *gpsdata,
+			 const char **endptr)
+{
+    int i, status;
+    const struct json_attr_t json_attrs_meas[] = {
+	/* *INDENT-OFF* */
+	{"gnssid",       t_ubyte,  STRUCTOBJECT(struct meas_t, gnssid)},
+	{"svid",         t_ubyte,  STRUCTOBJECT(struct meas_t, svid)},
+	{"sigid",        t_ubyte,  STRUCTOBJECT(struct meas_t, sigid)},
+	{"freqid",       t_ubyte,  STRUCTOBJECT(struct meas_t, freqid)},
+	{"snr",          t_ubyte,  STRUCTOBJECT(struct meas_t, snr)},
+	{"locktime",     t_ushort, STRUCTOBJECT(struct meas_t, locktime)},
+	{"pseudorange",  t_real,   STRUCTOBJECT(struct meas_t, pseudorange),
+				      .dflt.real = NAN},
+	{"carrierphase", t_real,   STRUCTOBJECT(struct meas_t, carrierphase),
+				      .dflt.real = NAN},
+	{"doppler",      t_real,   STRUCTOBJECT(struct meas_t, doppler),
+				      .dflt.real = NAN},
+	/* *INDENT-ON* */
+	{NULL},
+    };
+    const struct json_attr_t json_attrs_raw[] = {
+	/* *INDENT-OFF* */
+	{"class",      t_check,   .dflt.check = "RAW"},
+	{"device",     t_string,  .addr.string  = gpsdata->dev.path,
+	                             .len = sizeof(gpsdata->dev.path)},
+	{"time",       t_time,    .addr.real = &gpsdata->rawmeas.mtime,
+	      	                     .dflt.real = NAN},
+	{"rawdata",    t_array,   STRUCTARRAY(gpsdata->rawmeas.meas,
+					      json_attrs_meas,
+					      &gpsdata->rawmeas.nmeas)},
+	{"nmeas",      t_ignore},	/* only sent when rawdata is cut */
+	/* *INDENT-ON* */
+	{NULL},
+    };
+
+    gpsdata->rawmeas.nmeas = 0;
+    status = json_read_object(buf, json_attrs_raw, endptr);
+    if (status != 0)
+	return status;
+    /* tracking status isn't shipped, recover what the fields imply */
+    for (i = 0; i < gpsdata->rawmeas.nmeas; i++) {
+	struct meas_t *meas = &gpsdata->rawmeas.meas[i];
+
+	meas->satstat = SAT_ACQUIRED;
+	if (isfinite(meas->pseudorange) != 0)
+	    meas->satstat |= SAT_CODE_TRACK;
+	if (isfinite(meas->carrierphase) != 0)
+	    meas->satstat |= SAT_CARR_TRACK;
+    }
+    return 0;
+}
+
 int libgps_json_unpack(const char *buf,
 		       struct gps_data_t *gpsdata, const char **end)
 /* the only entry point - unpack a JSON object into gpsdata_t substructures */
@@ -528,7 +582,7 @@ int libgps_json_unpack(const char *buf,
 	}
 	return status;
     } else if (str_starts_with(classtag, "\"class\":\"DEVICE\"")) {
-	status = json_device_read(buf, &gpsdata->dev, end);
+	status = json_device_read(buf, &gpsdata->dev, NULL, 0, end);
 	if (status == 0)
 	    gpsdata->set |= DEVICE_SET;
 	return status;
@@ -600,6 +654,13 @@ int libgps_json_unpack(const char *buf,
 	    gpsdata->set |= PPS_SET;
 	}
 	return status;
+    } else if (str_starts_with(classtag, "\"class\":\"RAW\"")) {
+	status = json_raw_read(buf, gpsdata, end);
+	if (status == 0) {
+	    gpsdata->set &= ~UNION_SET;
+	    gpsdata->set |= RAW_SET;
+	}
+	return status;
     } else if (str_starts_with(classtag, "\"class\":\"OSC\"")) {
 	status = json_oscillator_read(buf, gpsdata, end);
 	if (status == 0) {
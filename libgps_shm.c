@@ -124,18 +124,14 @@ int gps_shm_read(struct gps_data_t *gpsdata)
 	 */
 	before = shared->bookend1;
 	memory_barrier();
-	(void)memcpy((void *)&noclobber,
-		     (void *)&shared->gpsdata,
-		     sizeof(struct gps_data_t));
+	gps_data_copy(&noclobber, (struct gps_data_t *)&shared->gpsdata);
 	memory_barrier();
 	after = shared->bookend2;
 
 	if (before != after)
 	    return 0;
 	else {
-	    (void)memcpy((void *)gpsdata,
-			 (void *)&noclobber,
-			 sizeof(struct gps_data_t));
+	    gps_data_copy(gpsdata, &noclobber);
 	    gpsdata->privdata = private_save;
 #ifndef USE_QT
 	    gpsdata->gps_fd = SHM_PSEUDO_FD;
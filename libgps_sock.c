@@ -45,7 +45,7 @@ struct privdata_t
     bool newstyle;
     /* data buffered from the last read */
     ssize_t waiting;
-    char buffer[GPS_JSON_RESPONSE_MAX * 2];
+    char buffer[GPS_JSON_RAW_MAX * 2];
 #ifdef LIBGPS_DEBUG
     int waitcount;
 #endif /* LIBGPS_DEBUG */
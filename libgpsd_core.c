@@ -213,7 +213,7 @@ const char *gpsd_prettydump(struct gps_device_t *session)
 /* dump the current packet in a form optimised for eyeballs */
 {
     return gpsd_packetdump(session->msgbuf, sizeof(session->msgbuf),
-			   (char *)session->lexer.outbuffer,
+			   (const char *)session->lexer.frame,
 			   session->lexer.outbuflen);
 }
 
@@ -251,6 +251,77 @@ static void gpsd_run_device_hook(struct gpsd_errout_t *errout,
     }
 }
 
+/*
+ * Once a device has been steadily sending packets for a while, the
+ * daemon tells the lexer to hunt only for the packet types it has
+ * actually seen, plus whatever its driver may switch it to.  Noise
+ * that merely looks like the start of some other protocol then no
+ * longer costs a trip down that protocol's states.  Anything that
+ * might change what the device sends widens the hunt again, and so
+ * does the lexer skipping the leaders of a type it has ruled out, or
+ * simply SETTLE_RECHECK packets going by, so a protocol the device
+ * starts sending later isn't lost for good.
+ */
+#define SETTLE_PACKETS	100	/* packets before narrowing the hunt */
+#define SETTLE_RECHECK	1000	/* packets before widening it again */
+#define SETTLE_MISSES	8	/* ruled-out leaders that widen it at once */
+
+static unsigned int pinned_typemask(const struct gps_device_t *session)
+/* the lexer typemask the user asked for, 0 for every type */
+{
+    return session->pinned_types == PINNED_ALL ? 0 : session->pinned_types;
+}
+
+void gpsd_lexer_unsettle(struct gps_device_t *session)
+/* hunt for every packet type the user hasn't ruled out */
+{
+    if (session->lexer.typemask != 0 && pinned_typemask(session) == 0)
+	gpsd_log(&session->context->errout, LOG_PROG,
+		 "%s: lexer hunting all packet types\n",
+		 session->gpsdata.dev.path);
+    packet_typemask(&session->lexer, pinned_typemask(session));
+    session->settle_count = 0;
+}
+
+static void lexer_settle(struct gps_device_t *session)
+/* narrow the lexer's hunt to what this device sends */
+{
+    struct gps_lexer_t *lexer = &session->lexer;
+    unsigned int types;
+
+    session->settle_chars = lexer->char_counter;
+    if (session->pinned_types != 0) {
+	/* the lexer was reset since the user pinned it */
+	if (lexer->typemask == 0 && session->pinned_types != PINNED_ALL)
+	    packet_typemask(lexer, session->pinned_types);
+	return;
+    }
+    if (lexer->typemask != 0) {
+	/* settled; widen again if something new may be coming in */
+	if (lexer->missed_leaders >= SETTLE_MISSES
+	    || ++session->settle_count >= SETTLE_PACKETS + SETTLE_RECHECK)
+	    gpsd_lexer_unsettle(session);
+	return;
+    }
+    if (!session->context->settle_lexer
+	|| session->device_type == NULL
+	|| ++session->settle_count < SETTLE_PACKETS)
+	return;
+
+    types = (unsigned int)session->observed
+	| PACKET_TYPEMASK(lexer->type)
+	| PACKET_TYPEMASK(session->device_type->packet_type);
+#ifdef RECONFIGURE_ENABLE
+    /* drivers that can switch modes can be switched back to NMEA */
+    if (session->device_type->mode_switcher != NULL)
+	types |= PACKET_TYPEMASK(NMEA_PACKET);
+#endif /* RECONFIGURE_ENABLE */
+    packet_typemask(lexer, types);
+    gpsd_log(&session->context->errout, LOG_PROG,
+	     "%s: lexer settled on packet types 0x%x\n",
+	     session->gpsdata.dev.path, lexer->typemask);
+}
+
 int gpsd_switch_driver(struct gps_device_t *session, char *type_name)
 {
     const struct gps_type_t **dp;
@@ -270,6 +341,8 @@ int gpsd_switch_driver(struct gps_device_t *session, char *type_name)
 	    gpsd_assert_sync(session);
 	    session->device_type = *dp;
 	    session->driver_index = i;
+	    /* the new driver may want packets the old one didn't */
+	    gpsd_lexer_unsettle(session);
 #ifdef RECONFIGURE_ENABLE
 	    session->gpsdata.dev.mincycle = session->device_type->min_cycle;
 #endif /* RECONFIGURE_ENABLE */
@@ -318,6 +391,9 @@ void gpsd_init(struct gps_device_t *session, struct gps_context_t *context,
     session->last_controller = NULL;
 #endif /* RECONFIGURE_ENABLE */
     session->observed = 0;
+    session->pinned_types = 0;
+    session->settle_count = 0;
+    session->settle_chars = 0;
     session->sourcetype = source_unknown;	/* gpsd_open() sets this */
     session->servicetype = service_unknown;	/* gpsd_open() sets this */
     session->context = context;
@@ -1043,11 +1119,29 @@ int gpsd_await_data(fd_set *rfds,
 		     fd_set *all_fds,
 		     struct gpsd_errout_t *errout)
 /* await data from any socket in the all_fds set */
+{
+    return gpsd_await_io(rfds, NULL, efds, maxfd, all_fds, NULL, errout);
+}
+
+int gpsd_await_io(fd_set *rfds,
+		  fd_set *wfds,
+		  fd_set *efds,
+		  const int maxfd,
+		  fd_set *all_fds,
+		  fd_set *out_fds,
+		  struct gpsd_errout_t *errout)
+/* await data from the all_fds set, or room to write on the out_fds set */
 {
     int status;
 
     FD_ZERO(efds);
     *rfds = *all_fds;
+    if (wfds != NULL) {
+	if (out_fds != NULL)
+	    *wfds = *out_fds;
+	else
+	    FD_ZERO(wfds);
+    }
     gpsd_log(errout, LOG_RAW + 2, "select waits\n");
     /*
      * Poll for user commands or GPS data.  The timeout doesn't
@@ -1063,7 +1157,7 @@ int gpsd_await_data(fd_set *rfds,
      */
     errno = 0;
 
-    status = pselect(maxfd + 1, rfds, NULL, NULL, NULL, NULL);
+    status = pselect(maxfd + 1, rfds, wfds, NULL, NULL, NULL);
     if (status == -1) {
 	if (errno == EINTR)
 	    return AWAIT_NOT_READY;
@@ -1105,6 +1199,42 @@ int gpsd_await_data(fd_set *rfds,
     return AWAIT_GOT_INPUT;
 }
 
+#ifdef EPOLL_ENABLE
+int gpsd_await_events(int epfd,
+		      struct epoll_event *events,
+		      int maxevents, int *nready,
+		      struct gpsd_errout_t *errout)
+/* await readiness events on an epoll instance */
+{
+    int status;
+
+    *nready = 0;
+    gpsd_log(errout, LOG_RAW + 2, "epoll waits\n");
+    /*
+     * Unlike pselect(), the cost of this call does not depend on the
+     * highest descriptor number or on the number of idle descriptors,
+     * and there is no FD_SETSIZE ceiling.  The interest list is level
+     * triggered, so a device or client that is not fully drained
+     * will be reported again on the next call.
+     */
+    errno = 0;
+
+    status = epoll_wait(epfd, events, maxevents, -1);
+    if (status == -1) {
+	if (errno == EINTR)
+	    return AWAIT_NOT_READY;
+	gpsd_log(errout, LOG_ERROR, "epoll_wait: %s\n", strerror(errno));
+	return AWAIT_FAILED;
+    }
+    *nready = status;
+
+    gpsd_log(errout, LOG_SPIN,
+	     "epoll_wait() -> %d events at %f\n", status, timestamp());
+
+    return AWAIT_GOT_INPUT;
+}
+#endif /* EPOLL_ENABLE */
+
 static bool hunt_failure(struct gps_device_t *session)
 /* after a bad packet, what should cue us to go to next autobaud setting? */
 {
@@ -1328,6 +1458,12 @@ gps_mask_t gpsd_poll(struct gps_device_t *session)
 	gpsd_log(&session->context->errout, LOG_RAW + 3,
 		 "New data on %s, not yet a packet\n",
 		 session->gpsdata.dev.path);
+	/* a settled lexer finding nothing may have missed a change */
+	if (session->lexer.typemask != 0 && session->pinned_types == 0
+	    && (session->lexer.missed_leaders >= SETTLE_MISSES
+		|| session->lexer.char_counter - session->settle_chars
+		   > 2 * MAX_PACKET_LENGTH))
+	    gpsd_lexer_unsettle(session);
 	return ONLINE_SET;
     } else {			/* we have recognized a packet */
 	gps_mask_t received = PACKET_SET;
@@ -1377,6 +1513,8 @@ gps_mask_t gpsd_poll(struct gps_device_t *session)
 	} else
 	    session->lexer.counter++;
 
+	lexer_settle(session);
+
 	/* fire the configure hook */
 	if (session->device_type != NULL
 	    && session->device_type->event_hook != NULL)
@@ -53,6 +53,6 @@ class LIBQGPSMMSHARED_EXPORT gpsmm {
 						  const char *port);
 		struct gps_data_t _gps_state;
 		struct gps_data_t * gps_state() { return &_gps_state; }
-		struct gps_data_t* backup(void) { *to_user=*gps_state(); return to_user;}; //return the backup copy
+		struct gps_data_t* backup(void) { gps_data_copy(to_user, gps_state()); return to_user;}; //return the backup copy
 };
 #endif // _GPSD_GPSMM_H_
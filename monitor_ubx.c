@@ -91,7 +91,7 @@ static bool ubx_initialize(void)
     return true;
 }
 
-static void display_nav_svinfo(unsigned char *buf, size_t data_len)
+static void display_nav_svinfo(const unsigned char *buf, size_t data_len)
 {
     int i, nchan;
 
@@ -122,7 +122,7 @@ static void display_nav_svinfo(unsigned char *buf, size_t data_len)
     return;
 }
 
-static void display_nav_sol(unsigned char *buf, size_t data_len)
+static void display_nav_sol(const unsigned char *buf, size_t data_len)
 {
     unsigned short gw = 0;
     unsigned int tow = 0, flags;
@@ -209,7 +209,7 @@ static void display_nav_sol(unsigned char *buf, size_t data_len)
 }
 
 
-static void display_nav_dop(unsigned char *buf, size_t data_len)
+static void display_nav_dop(const unsigned char *buf, size_t data_len)
 {
     if (data_len != 18)
 	return;
@@ -228,11 +228,11 @@ static void display_nav_dop(unsigned char *buf, size_t data_len)
 
 static void ubx_update(void)
 {
-    unsigned char *buf;
+    const unsigned char *buf;
     size_t data_len;
     unsigned short msgid;
 
-    buf = session.lexer.outbuffer;
+    buf = session.lexer.frame;
     msgid = (unsigned short)((buf[2] << 8) | buf[3]);
     data_len = (size_t) getles16(buf, 4);
     switch (msgid) {
@@ -36,6 +36,11 @@ PERMISSIONS
 #include <netinet/in.h>
 #include <arpa/inet.h>		/* for htons() */
 #include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "bits.h"
 #include "driver_greis.h"
@@ -129,6 +134,19 @@ static char *state_table[] = {
 #include "packet_names.h"
 };
 
+/*
+ * The framing states that only look at the current character are run
+ * from a transition table generated by packet_dfa.py rather than from
+ * the switch in nextstate().  An entry is the next state shifted left
+ * two bits, plus what to do with the character; zero means the state
+ * isn't table-driven.
+ */
+#define DFA_GOTO(s)	((unsigned short)((s) << 2 | 1))	/* consume it */
+#define DFA_RETRY(s)	((unsigned short)((s) << 2 | 2))	/* rescan it in s */
+#define DFA_RESYNC(s)	((unsigned short)((s) << 2 | 3))	/* drop it, go to s */
+
+#include "packet_dfa.h"
+
 #define SOH	(unsigned char)0x01
 #define DLE	(unsigned char)0x10
 #define STX	(unsigned char)0x02
@@ -234,9 +252,11 @@ static bool character_pushback(struct gps_lexer_t *lexer, unsigned int newstate)
 }
 
 static void character_discard(struct gps_lexer_t *lexer)
-/* shift the input buffer to discard one character and reread data */
+/* slide the input window past one character and reread data */
 {
-    memmove(lexer->inbuffer, lexer->inbuffer + 1, (size_t)-- lexer->inbuflen);
+    lexer->inbuffer++;
+    if (--lexer->inbuflen == 0)
+	lexer->inbuffer = lexer->inbufstore;
     lexer->inbufptr = lexer->inbuffer;
     if (lexer->errout.debug >= LOG_RAW+1) {
 	char scratchbuf[MAX_PACKET_LENGTH*4+1];
@@ -248,22 +268,249 @@ static void character_discard(struct gps_lexer_t *lexer)
     }
 }
 
+/*
+ * Bytes that nextstate() does anything with in GROUND_STATE, and the
+ * packet types each may start.  Keep this in step with the
+ * GROUND_STATE case there; any other byte is simply discarded, which
+ * lets packet_parse() skip runs of them in one go.  With RTCM2 on,
+ * every byte with the ISGPS data tag (0x40-0x7f) also has to go
+ * through the decoder.
+ */
+#define NMEA_TYPES	(PACKET_TYPEMASK(NMEA_PACKET) | PACKET_TYPEMASK(AIVDM_PACKET))
+static const struct {
+    unsigned char c;
+    unsigned int types;
+} ground_leaders[] = {
+    {'#', PACKET_TYPEMASK(COMMENT_PACKET)},
+#ifdef NMEA0183_ENABLE
+    {'$', NMEA_TYPES},
+    {'!', NMEA_TYPES},
+#endif /* NMEA0183_ENABLE */
+#if defined(TNT_ENABLE) || defined(GARMINTXT_ENABLE) || defined(ONCORE_ENABLE)
+    {'@', PACKET_TYPEMASK(NMEA_PACKET) | PACKET_TYPEMASK(GARMINTXT_PACKET)
+	| PACKET_TYPEMASK(ONCORE_PACKET)},
+#endif
+#if defined(SIRF_ENABLE) || defined(SKYTRAQ_ENABLE)
+    {0xa0, PACKET_TYPEMASK(SIRF_PACKET) | PACKET_TYPEMASK(SKY_PACKET)},
+#endif /* SIRF_ENABLE || SKYTRAQ_ENABLE */
+#ifdef SUPERSTAR2_ENABLE
+    {SOH, PACKET_TYPEMASK(SUPERSTAR2_PACKET)},
+#endif /* SUPERSTAR2_ENABLE */
+#if defined(TSIP_ENABLE) || defined(EVERMORE_ENABLE) || defined(GARMIN_ENABLE)
+    {DLE, PACKET_TYPEMASK(TSIP_PACKET) | PACKET_TYPEMASK(EVERMORE_PACKET)
+	| PACKET_TYPEMASK(GARMIN_PACKET)},
+#endif /* TSIP_ENABLE || EVERMORE_ENABLE || GARMIN_ENABLE */
+#ifdef TRIPMATE_ENABLE
+    {'A', PACKET_TYPEMASK(NMEA_PACKET)},
+#endif /* TRIPMATE_ENABLE */
+#ifdef EARTHMATE_ENABLE
+    {'E', PACKET_TYPEMASK(NMEA_PACKET)},
+#endif /* EARTHMATE_ENABLE */
+#ifdef ZODIAC_ENABLE
+    {0xff, PACKET_TYPEMASK(ZODIAC_PACKET)},
+#endif /* ZODIAC_ENABLE */
+#ifdef UBLOX_ENABLE
+    {0xb5, PACKET_TYPEMASK(UBX_PACKET)},
+#endif /* UBLOX_ENABLE */
+#ifdef ITRAX_ENABLE
+    {'<', PACKET_TYPEMASK(ITALK_PACKET)},
+#endif /* ITRAX_ENABLE */
+#ifdef NAVCOM_ENABLE
+    {0x02, PACKET_TYPEMASK(NAVCOM_PACKET)},
+#endif /* NAVCOM_ENABLE */
+#ifdef GEOSTAR_ENABLE
+    {'P', PACKET_TYPEMASK(GEOSTAR_PACKET)},
+#endif /* GEOSTAR_ENABLE */
+#ifdef GREIS_ENABLE
+    {'R', PACKET_TYPEMASK(GREIS_PACKET)},
+    {'~', PACKET_TYPEMASK(GREIS_PACKET)},
+#endif /* GREIS_ENABLE */
+#ifdef RTCM104V3_ENABLE
+    {0xD3, PACKET_TYPEMASK(RTCM3_PACKET)},
+#endif /* RTCM104V3_ENABLE */
+#ifdef PASSTHROUGH_ENABLE
+    {'{', PACKET_TYPEMASK(JSON_PACKET)},
+#endif /* PASSTHROUGH_ENABLE */
+};
+
+/* is a packet type one this lexer is looking for? */
+#define WANTED(lexer, type) \
+    ((lexer)->typemask == 0 || ((lexer)->typemask & PACKET_TYPEMASK(type)) != 0)
+
+static bool ground_leader(const struct gps_lexer_t *lexer, unsigned char c)
+{
+#ifdef RTCM104V2_ENABLE
+    if ((c & 0xc0) == 0x40 && WANTED(lexer, RTCM2_PACKET))
+	return true;
+#endif /* RTCM104V2_ENABLE */
+    return memchr(lexer->leaders, c, lexer->nleaders) != NULL;
+}
+
+static bool missed_leader(const struct gps_lexer_t *lexer, unsigned char c)
+/* does c start a packet type this lexer has stopped hunting for? */
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(ground_leaders) / sizeof(ground_leaders[0]); i++)
+	if (ground_leaders[i].c == c)
+	    return (ground_leaders[i].types & lexer->typemask) == 0;
+    return false;
+}
+
+static size_t ground_scan(const struct gps_lexer_t *lexer,
+			  const unsigned char *buf, size_t len)
+/* how many bytes at buf GROUND_STATE would discard unread */
+{
+    const unsigned char *leaders = lexer->leaders;
+    size_t nleaders = lexer->nleaders;
+    size_t n = 0;
+#ifdef RTCM104V2_ENABLE
+    bool rtcm2 = WANTED(lexer, RTCM2_PACKET);
+#endif /* RTCM104V2_ENABLE */
+
+#if defined(__SSE2__)
+    for (; n + 16 <= len; n += 16) {
+	__m128i block = _mm_loadu_si128((const __m128i *)(buf + n));
+	__m128i hit = _mm_setzero_si128();
+	unsigned int mask;
+	size_t i;
+
+#ifdef RTCM104V2_ENABLE
+	if (rtcm2)
+	    hit = _mm_cmpeq_epi8(_mm_and_si128(block,
+					       _mm_set1_epi8((char)0xc0)),
+				 _mm_set1_epi8(0x40));
+#endif /* RTCM104V2_ENABLE */
+	for (i = 0; i < nleaders; i++)
+	    hit = _mm_or_si128(hit,
+			       _mm_cmpeq_epi8(block,
+					 _mm_set1_epi8((char)leaders[i])));
+	mask = (unsigned int)_mm_movemask_epi8(hit);
+	if (mask != 0)
+	    return n + (size_t)__builtin_ctz(mask);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; n + 16 <= len; n += 16) {
+	uint8x16_t block = vld1q_u8(buf + n);
+	uint8x16_t hit = vdupq_n_u8(0);
+	size_t i;
+
+#ifdef RTCM104V2_ENABLE
+	if (rtcm2)
+	    hit = vceqq_u8(vandq_u8(block, vdupq_n_u8(0xc0)),
+			   vdupq_n_u8(0x40));
+#endif /* RTCM104V2_ENABLE */
+	for (i = 0; i < nleaders; i++)
+	    hit = vorrq_u8(hit, vceqq_u8(block, vdupq_n_u8(leaders[i])));
+	if (vmaxvq_u8(hit) != 0)
+	    break;		/* the scalar loop finds which byte */
+    }
+#endif
+    for (; n < len; n++)
+	if (ground_leader(lexer, buf[n]))
+	    break;
+    return n;
+}
+
+#ifdef NMEA0183_ENABLE
+static size_t nmea_body_scan(const unsigned char *buf, size_t len)
+/* how many bytes at buf NMEA_LEADER_END would take without leaving */
+{
+    size_t n = 0;
+
+    /* anything unprintable, or a '$', ends the run */
+#if defined(__SSE2__)
+    for (; n + 16 <= len; n += 16) {
+	__m128i block = _mm_loadu_si128((const __m128i *)(buf + n));
+	/* signed compare, so 0x80-0xff count as below ' ' too */
+	__m128i hit = _mm_or_si128(_mm_cmplt_epi8(block, _mm_set1_epi8(' ')),
+				   _mm_or_si128(_mm_cmpeq_epi8(block,
+						       _mm_set1_epi8(0x7f)),
+						_mm_cmpeq_epi8(block,
+						       _mm_set1_epi8('$'))));
+	unsigned int mask = (unsigned int)_mm_movemask_epi8(hit);
+
+	if (mask != 0)
+	    return n + (size_t)__builtin_ctz(mask);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; n + 16 <= len; n += 16) {
+	uint8x16_t block = vld1q_u8(buf + n);
+	uint8x16_t hit = vorrq_u8(vorrq_u8(vcltq_u8(block, vdupq_n_u8(' ')),
+					   vcgtq_u8(block, vdupq_n_u8('~'))),
+				  vceqq_u8(block, vdupq_n_u8('$')));
+
+	if (vmaxvq_u8(hit) != 0)
+	    break;		/* the scalar loop finds which byte */
+    }
+#endif
+    for (; n < len; n++)
+	if (buf[n] < ' ' || buf[n] > '~' || buf[n] == '$')
+	    break;
+    return n;
+}
+
+static unsigned int nmea_xor(const unsigned char *buf, size_t len)
+/* XOR of len bytes, a machine word at a time */
+{
+    uint64_t word, acc = 0;
+    unsigned int crc;
+
+    for (; len >= sizeof(word); buf += sizeof(word), len -= sizeof(word)) {
+	memcpy(&word, buf, sizeof(word));
+	acc ^= word;
+    }
+    acc ^= acc >> 32;
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    crc = (unsigned int)(acc & 0xff);
+    while (len-- > 0)
+	crc ^= *buf++;
+    return crc;
+}
+#endif /* NMEA0183_ENABLE */
+
 static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 {
-    static int n = 0;
 #ifdef RTCM104V2_ENABLE
     enum isgpsstat_t isgpsstat;
 #endif /* RTCM104V2_ENABLE */
-#ifdef SUPERSTAR2_ENABLE
-    static unsigned char ctmp;
-#endif /* SUPERSTAR2_ENABLE */
-    n++;
+    unsigned short t;
+
+    if (lexer->state < sizeof(dfa_table) / sizeof(dfa_table[0])
+	&& (t = dfa_table[lexer->state][dfa_class[c]]) != 0) {
+	switch (t & 3) {
+	case 1:
+	    lexer->state = t >> 2;
+	    return true;
+	case 2:
+	    return character_pushback(lexer, t >> 2);
+	default:
+	    (void) character_pushback(lexer, t >> 2);
+	    return true;
+	}
+    }
     switch (lexer->state) {
     case GROUND_STATE:
-	n = 0;
 #ifdef STASH_ENABLE
 	lexer->stashbuflen = 0;
 #endif
+	if (lexer->typemask != 0
+	    && memchr(lexer->leaders, c, lexer->nleaders) == NULL) {
+	    /* nothing this lexer is looking for starts here... */
+	    if (missed_leader(lexer, c))
+		lexer->missed_leaders++;
+#ifdef RTCM104V2_ENABLE
+	    /* ...except maybe RTCM2, which can start anywhere */
+	    if (WANTED(lexer, RTCM2_PACKET)) {
+		if ((isgpsstat = rtcm2_decode(lexer, c)) == ISGPS_SYNC)
+		    lexer->state = RTCM2_SYNC_STATE;
+		else if (isgpsstat == ISGPS_MESSAGE)
+		    lexer->state = RTCM2_RECOGNIZED;
+	    }
+#endif /* RTCM104V2_ENABLE */
+	    break;
+	}
 	if (c == '#') {
 	    lexer->state = COMMENT_BODY;
 	    break;
@@ -281,7 +528,8 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 #if defined(TNT_ENABLE) || defined(GARMINTXT_ENABLE) || defined(ONCORE_ENABLE)
 	if (c == '@') {
 #ifdef RTCM104V2_ENABLE
-	    if (rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
+	    if (WANTED(lexer, RTCM2_PACKET)
+		&& rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
 		lexer->state = RTCM2_RECOGNIZED;
 		break;
 	    }
@@ -311,7 +559,8 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 #ifdef TRIPMATE_ENABLE
 	if (c == 'A') {
 #ifdef RTCM104V2_ENABLE
-	    if (rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
+	    if (WANTED(lexer, RTCM2_PACKET)
+		&& rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
 		lexer->state = RTCM2_RECOGNIZED;
 		break;
 	    }
@@ -323,7 +572,8 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 #ifdef EARTHMATE_ENABLE
 	if (c == 'E') {
 #ifdef RTCM104V2_ENABLE
-	    if (rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
+	    if (WANTED(lexer, RTCM2_PACKET)
+		&& rtcm2_decode(lexer, c) == ISGPS_MESSAGE) {
 		lexer->state = RTCM2_RECOGNIZED;
 		break;
 	    }
@@ -374,7 +624,9 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	}
 #endif /* GREIS_ENABLE */
 #ifdef RTCM104V2_ENABLE
-	if ((isgpsstat = rtcm2_decode(lexer, c)) == ISGPS_SYNC) {
+	if (!WANTED(lexer, RTCM2_PACKET))
+	    ;
+	else if ((isgpsstat = rtcm2_decode(lexer, c)) == ISGPS_SYNC) {
 	    lexer->state = RTCM2_SYNC_STATE;
 	    break;
 	} else if (isgpsstat == ISGPS_MESSAGE) {
@@ -393,155 +645,7 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	    return character_pushback(lexer, JSON_LEADER);
 #endif /* PASSTHROUGH_ENABLE */
 	break;
-    case COMMENT_BODY:
-	if (c == '\n')
-	    lexer->state = COMMENT_RECOGNIZED;
-	else if (!isprint(c))
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
 #ifdef NMEA0183_ENABLE
-    case NMEA_DOLLAR:
-	if (c == 'G')
-	    lexer->state = NMEA_PUB_LEAD;
-	else if (c == 'P')	/* vendor sentence */
-	    lexer->state = NMEA_VENDOR_LEAD;
-	else if (c == 'I')	/* Seatalk */
-	    lexer->state = SEATALK_LEAD_1;
-	else if (c == 'W')	/* Weather instrument */
-	    lexer->state = WEATHER_LEAD_1;
-	else if (c == 'H')	/* Heading/compass */
-	    lexer->state = HEADCOMP_LEAD_1;
-	else if (c == 'T')	/* Turn indicator */
-	    lexer->state = TURN_LEAD_1;
-	else if (c == 'A')	/* SiRF Ack */
-	    lexer->state = SIRF_ACK_LEAD_1;
-	else if (c == 'E')	/* ECDIS */
-	    lexer->state = ECDIS_LEAD_1;
-	else if (c == 'S')
-	    lexer->state = SOUNDER_LEAD_1;
-	else if (c == 'Y')
-	    lexer->state = TRANSDUCER_LEAD_1;
-	else if (c == 'B')
-	    lexer->state = BEIDOU_LEAD_1;
-	else if (c == 'Q')
-	    lexer->state = QZSS_LEAD_1;
-#ifdef OCEANSERVER_ENABLE
-	else if (c == 'C')
-	    lexer->state = NMEA_LEADER_END;
-#endif /* OCEANSERVER_ENABLE */
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_PUB_LEAD:
-	/*
-	 * $GP == GPS, $GL = GLONASS only, $GN = mixed GPS and GLONASS,
-	 * according to NMEA (IEIC 61162-1) DRAFT 02/06/2009.
-	 * We have a log from China with a Beidou device using $GB
-	 * rather than $BD.
-	 */
-	if (c == 'B' || c == 'P' || c == 'N' || c == 'L' || c == 'A')
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_VENDOR_LEAD:
-	if (c == 'A')
-	    lexer->state = NMEA_PASHR_A;
-	else if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    /*
-     * Without the following six states, DLE in a $PASHR can fool the
-     * sniffer into thinking it sees a TSIP packet.  Hilarity ensues.
-     */
-    case NMEA_PASHR_A:
-	if (c == 'S')
-	    lexer->state = NMEA_PASHR_S;
-	else if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_PASHR_S:
-	if (c == 'H')
-	    lexer->state = NMEA_PASHR_H;
-	else if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_PASHR_H:
-	if (c == 'R')
-	    lexer->state = NMEA_BINARY_BODY;
-	else if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_BINARY_BODY:
-	if (c == '\r')
-	    lexer->state = NMEA_BINARY_CR;
-	break;
-    case NMEA_BINARY_CR:
-	if (c == '\n')
-	    lexer->state = NMEA_BINARY_NL;
-	else
-	    lexer->state = NMEA_BINARY_BODY;
-	break;
-    case NMEA_BINARY_NL:
-	if (c == '$')
-	    (void) character_pushback(lexer, NMEA_RECOGNIZED);
-	else
-	    lexer->state = NMEA_BINARY_BODY;
-	break;
-    case NMEA_BANG:
-	if (c == 'A')
-	    lexer->state = AIS_LEAD_1;
-	else if (c == 'B')
-	    lexer->state = AIS_LEAD_ALT1;
-	else if (c == 'S')
-	    lexer->state = AIS_LEAD_ALT3;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_1:
-	if (strchr("BDINRSTX", c) != NULL)
-	    lexer->state = AIS_LEAD_2;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_2:
-	if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_ALT1:
-	if (c == 'S')
-	    lexer->state = AIS_LEAD_ALT2;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_ALT2:
-	if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_ALT3:
-	if (c == 'A')
-	    lexer->state = AIS_LEAD_ALT4;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case AIS_LEAD_ALT4:
-	if (isalpha(c))
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
 #if defined(TNT_ENABLE) || defined(GARMINTXT_ENABLE) || defined(ONCORE_ENABLE)
     case AT1_LEADER:
 	switch (c) {
@@ -579,109 +683,6 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	}
 	break;
 #endif /* defined(TNT_ENABLE) || defined(GARMINTXT_ENABLE) || defined(ONCORE_ENABLE) */
-    case NMEA_LEADER_END:
-	if (c == '\r')
-	    lexer->state = NMEA_CR;
-	else if (c == '\n')
-	    /* not strictly correct, but helps for interpreting logfiles */
-	    lexer->state = NMEA_RECOGNIZED;
-	else if (c == '$') {
-#ifdef STASH_ENABLE
-	    (void) character_pushback(lexer, STASH_RECOGNIZED);
-#else
-	    (void) character_pushback(lexer, GROUND_STATE);
-#endif
-	} else if (!isprint(c))
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_CR:
-	if (c == '\n')
-	    lexer->state = NMEA_RECOGNIZED;
-	/*
-	 * There's a GPS called a Jackson Labs Firefly-1a that emits \r\r\n
-	 * at the end of each sentence.  Don't be confused by this.
-	 */
-	else if (c == '\r')
-	    lexer->state = NMEA_CR;
-	else
-	    (void) character_pushback(lexer, GROUND_STATE);
-	break;
-    case NMEA_RECOGNIZED:
-	if (c == '#')
-	    lexer->state = COMMENT_BODY;
-	else if (c == '$')
-	    lexer->state = NMEA_DOLLAR;
-	else if (c == '!')
-	    lexer->state = NMEA_BANG;
-#ifdef UBLOX_ENABLE
-	else if (c == 0xb5)	/* LEA-5H can and will output NMEA and UBX back to back */
-	    lexer->state = UBX_LEADER_1;
-#endif
-#ifdef PASSTHROUGH_ENABLE
-	else if (c == '{')
-	    return character_pushback(lexer, JSON_LEADER);
-#endif /* PASSTHROUGH_ENABLE */
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case SEATALK_LEAD_1:
-	if (c == 'I' || c == 'N')	/* II or IN are accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case WEATHER_LEAD_1:
-	if (c == 'I')		/* Weather instrument leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case HEADCOMP_LEAD_1:
-	if (c == 'C')		/* Heading/compass leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case TURN_LEAD_1:
-	if (c == 'I')		/* Turn indicator leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case ECDIS_LEAD_1:
-	if (c == 'C')		/* ECDIS leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case SOUNDER_LEAD_1:
-	if (c == 'D')		/* Depth-sounder leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-#ifdef SKYTRAQ_ENABLE
-	else if (c == 'T')		/* $ST leader accepted, to $STI */
-	    lexer->state = NMEA_LEADER_END;
-#endif /* SKYTRAQ_ENABLE */
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case TRANSDUCER_LEAD_1:
-	if (c == 'X')		/* Transducer leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case BEIDOU_LEAD_1:
-	if (c == 'D')		/* Beidou leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case QZSS_LEAD_1:
-	if (c == 'Z')		/* QZSS leader accepted */
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
 #ifdef TRIPMATE_ENABLE
     case ASTRAL_1:
 	if (c == 'S') {
@@ -836,20 +837,6 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	    (void) character_pushback(lexer, GROUND_STATE);
 	break;
 #endif /* EARTHMATE_ENABLE */
-    case SIRF_ACK_LEAD_1:
-	if (c == 'c')
-	    lexer->state = SIRF_ACK_LEAD_2;
-	else if (c == 'I')
-	    lexer->state = AIS_LEAD_2;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
-    case SIRF_ACK_LEAD_2:
-	if (c == 'k')
-	    lexer->state = NMEA_LEADER_END;
-	else
-	    return character_pushback(lexer, GROUND_STATE);
-	break;
 #endif /* NMEA0183_ENABLE */
 #if defined(SIRF_ENABLE) || defined(SKYTRAQ_ENABLE)
     case SIRF_LEADER_1:
@@ -933,6 +920,7 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	}
 	{
 	    unsigned char csum = 0;
+	    int n;
 	    for (n = 4;
 		 (unsigned char *)(lexer->inbuffer + n) < lexer->inbufptr - 1;
 		 n++)
@@ -965,11 +953,11 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 #endif /* SKYTRAQ */
 #ifdef SUPERSTAR2_ENABLE
     case SUPERSTAR2_LEADER:
-	ctmp = c;
 	lexer->state = SUPERSTAR2_ID1;
 	break;
     case SUPERSTAR2_ID1:
-	if ((ctmp ^ 0xff) == c)
+	/* the ID byte just before this one, still in the buffer */
+	if ((lexer->inbufptr[-2] ^ 0xff) == c)
 	    lexer->state = SUPERSTAR2_ID2;
 	else
 	    return character_pushback(lexer, GROUND_STATE);
@@ -1095,6 +1083,7 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
     case NAVCOM_PAYLOAD:
     {
 	unsigned char csum = lexer->inbuffer[3];
+	int n;
 	for (n = 4;
 	     (unsigned char *)(lexer->inbuffer + n) < lexer->inbufptr - 1;
 	     n++)
@@ -1233,7 +1222,8 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 	break;
     case UBX_LENGTH_1:
 	lexer->length += (c << 8);
-	if (lexer->length <= MAX_PACKET_LENGTH)
+	/* 6 bytes of header and 2 of checksum */
+	if (lexer->length <= MAX_FRAME_LENGTH - 8)
 	    lexer->state = UBX_LENGTH_2;
 	else
 	    return character_pushback(lexer, GROUND_STATE);
@@ -1627,25 +1617,32 @@ static bool nextstate(struct gps_lexer_t *lexer, unsigned char c)
 }
 
 static void packet_accept(struct gps_lexer_t *lexer, int packet_type)
-/* packet grab succeeded, move to output buffer */
+/* packet grab succeeded, hand it on */
 {
     size_t packetlen = lexer->inbufptr - lexer->inbuffer;
+    bool inplace = (PACKET_TYPEMASK(packet_type) & ZEROCOPY_TYPEMASK) != 0;
 
-    if (packetlen < sizeof(lexer->outbuffer)) {
-	memcpy(lexer->outbuffer, lexer->inbuffer, packetlen);
+    if (inplace || packetlen < sizeof(lexer->outbuffer)) {
+	lexer->frame = lexer->inbuffer;
 	lexer->outbuflen = packetlen;
-	lexer->outbuffer[packetlen] = '\0';
 	lexer->type = packet_type;
+	/* only the parsers that want a private copy get one */
+	if (!inplace) {
+	    memcpy(lexer->outbuffer, lexer->inbuffer, packetlen);
+	    lexer->outbuffer[packetlen] = '\0';
+	} else if (packetlen >= sizeof(lexer->outbuffer))
+	    lexer->long_frames++;
 	if (lexer->errout.debug >= LOG_RAW+1) {
 	    char scratchbuf[MAX_PACKET_LENGTH*4+1];
 	    gpsd_log(&lexer->errout, LOG_RAW+1,
 		     "Packet type %d accepted %zu = %s\n",
 		     packet_type, packetlen,
 		     gpsd_packetdump(scratchbuf,  sizeof(scratchbuf),
-				     (char *)lexer->outbuffer,
+				     (const char *)lexer->frame,
 				     lexer->outbuflen));
 	}
     } else {
+	lexer->overruns++;
 	gpsd_log(&lexer->errout, LOG_ERROR,
 		 "Rejected too long packet type %d len %zu\n",
 		 packet_type, packetlen);
@@ -1653,11 +1650,20 @@ static void packet_accept(struct gps_lexer_t *lexer, int packet_type)
 }
 
 static void packet_discard(struct gps_lexer_t *lexer)
-/* shift the input buffer to discard all data up to current input pointer */
+/* slide the input window past all data up to current input pointer */
 {
     size_t discard = lexer->inbufptr - lexer->inbuffer;
     size_t remaining = lexer->inbuflen - discard;
-    lexer->inbufptr = memmove(lexer->inbuffer, lexer->inbufptr, remaining);
+    /* an empty window may as well start over at the front */
+    bool restart = (remaining == 0);
+#ifdef STASH_ENABLE
+    /* ...unless a stash is about to go back in just ahead of it */
+    if (lexer->stashbuflen > 0)
+	restart = false;
+#endif /* STASH_ENABLE */
+    if (restart)
+	lexer->inbufptr = lexer->inbufstore;
+    lexer->inbuffer = lexer->inbufptr;
     lexer->inbuflen = remaining;
     if (lexer->errout.debug >= LOG_RAW+1) {
 	char scratchbuf[MAX_PACKET_LENGTH*4+1];
@@ -1669,6 +1675,54 @@ static void packet_discard(struct gps_lexer_t *lexer)
     }
 }
 
+static void packet_resync(struct gps_lexer_t *lexer)
+/*
+ * A long framed packet failed its checksum, so its length was likely
+ * noise too.  Rather than lose everything it spanned, drop only its
+ * first byte and scan the rest again for a real packet start.
+ */
+{
+    size_t span = lexer->inbufptr - lexer->inbuffer;
+
+    lexer->overruns++;
+    gpsd_log(&lexer->errout, LOG_IO,
+	     "bad %zu-char frame, rescanning it (%lu)\n",
+	     span, lexer->overruns);
+    lexer->inbufptr = lexer->inbuffer + 1;
+    lexer->char_counter -= span - 1;
+    lexer->state = GROUND_STATE;
+    packet_discard(lexer);
+}
+
+#ifdef UBLOX_ENABLE
+void ubx_checksum(const unsigned char *buf, size_t len,
+		  unsigned char *ck_a, unsigned char *ck_b)
+/*
+ * The UBX 8-bit Fletcher sum.  Eight steps of a += x; b += a add the
+ * eight bytes to a and 8a + 8x0 + 7x1 + ... + 1x7 to b, so take them
+ * a block at a time.  Only the low byte of either sum matters, and
+ * 32-bit wraparound keeps that intact.
+ */
+{
+    uint32_t a = 0, b = 0;
+    size_t n = 0;
+
+    for (; n + 8 <= len; n += 8) {
+	const unsigned char *x = buf + n;
+
+	b += 8 * a + 8 * x[0] + 7 * x[1] + 6 * x[2] + 5 * x[3]
+	    + 4 * x[4] + 3 * x[5] + 2 * x[6] + x[7];
+	a += x[0] + x[1] + x[2] + x[3] + x[4] + x[5] + x[6] + x[7];
+    }
+    for (; n < len; n++) {
+	a += buf[n];
+	b += a;
+    }
+    *ck_a = (unsigned char)a;
+    *ck_b = (unsigned char)b;
+}
+#endif /* UBLOX_ENABLE */
+
 #ifdef STASH_ENABLE
 static void packet_stash(struct gps_lexer_t *lexer)
 /* stash the input buffer up to current input pointer */
@@ -1691,12 +1745,22 @@ static void packet_stash(struct gps_lexer_t *lexer)
 static void packet_unstash(struct gps_lexer_t *lexer)
 /* return stash to start of input buffer */
 {
-    size_t available = sizeof(lexer->inbuffer) - lexer->inbuflen;
+    size_t available = sizeof(lexer->inbufstore) - lexer->inbuflen;
     size_t stashlen = lexer->stashbuflen;
 
     if (stashlen <= available) {
-	memmove(lexer->inbuffer + stashlen, lexer->inbuffer, lexer->inbuflen);
+	if ((size_t)(lexer->inbuffer - lexer->inbufstore) < stashlen) {
+	    memmove(lexer->inbufstore + stashlen, lexer->inbuffer,
+		    lexer->inbuflen);
+	    lexer->inbuffer = lexer->inbufstore + stashlen;
+	}
+	lexer->inbufptr = lexer->inbuffer -= stashlen;
 	memcpy(lexer->inbuffer, lexer->stashbuffer, stashlen);
+	/*
+	 * That went over the packet just accepted, an NMEA one, so only
+	 * its copy in outbuffer is left.
+	 */
+	lexer->frame = lexer->outbuffer;
 	lexer->inbuflen += stashlen;
 	lexer->stashbuflen = 0;
 	if (lexer->errout.debug >= LOG_RAW+1) {
@@ -1724,23 +1788,108 @@ void lexer_init(struct gps_lexer_t *lexer)
 {
     lexer->char_counter = 0;
     lexer->retry_counter = 0;
+    lexer->long_frames = 0;
+    lexer->overruns = 0;
 #ifdef PASSTHROUGH_ENABLE
     lexer->json_depth = 0;
 #endif /* PASSTHROUGH_ENABLE */
 #ifdef TIMING_ENABLE
     lexer->start_time = 0.0;
 #endif /* TIMING_ENABLE */
+    lexer->frame = lexer->outbuffer;
+    lexer->outbuflen = 0;
     packet_reset(lexer);
     errout_reset(&lexer->errout);
 }
 
+/*
+ * How much input a packet in progress may span before it is given up
+ * on.  This used to be the size of the whole input buffer.  Once the
+ * length of a UBX, GREIS or RTCM3 packet has been read and checked,
+ * though, the lexer knows how long to wait for the rest, and gives it
+ * up to MAX_FRAME_LENGTH rather than throw away a good partial frame.
+ */
+#define MAX_PACKET_SPAN	(MAX_PACKET_LENGTH*2+1)
+#define MAX_FRAME_SPAN	(MAX_FRAME_LENGTH+1)
+#define packet_span(lexer)	((size_t)((lexer)->inbufptr - (lexer)->inbuffer))
+
+static size_t span_limit(const struct gps_lexer_t *lexer)
+{
+    switch (lexer->state) {
+#ifdef UBLOX_ENABLE
+    case UBX_PAYLOAD:
+    case UBX_CHECKSUM_A:
+#endif /* UBLOX_ENABLE */
+#ifdef GREIS_ENABLE
+    case GREIS_PAYLOAD:
+#endif /* GREIS_ENABLE */
+#ifdef RTCM104V3_ENABLE
+    case RTCM3_PAYLOAD:
+#endif /* RTCM104V3_ENABLE */
+	return MAX_FRAME_SPAN;
+    default:
+	return MAX_PACKET_SPAN;
+    }
+}
+
 void packet_parse(struct gps_lexer_t *lexer)
 /* grab a packet from the input buffer */
 {
     lexer->outbuflen = 0;
-    while (packet_buffered_input(lexer) > 0) {
-	unsigned char c = *lexer->inbufptr++;
+    while (packet_buffered_input(lexer) > 0
+	   && packet_span(lexer) < span_limit(lexer)) {
+	unsigned char c;
 	unsigned int oldstate = lexer->state;
+
+	/* skip line noise between packets in one step */
+	if (lexer->state == GROUND_STATE && lexer->inbufptr == lexer->inbuffer) {
+	    size_t skip = ground_scan(lexer, lexer->inbuffer, lexer->inbuflen);
+
+	    if (skip > 0) {
+		/* tell the daemon if a type it ruled out turns up */
+		if (lexer->typemask != 0) {
+		    size_t i;
+
+		    for (i = 0; i < skip; i++)
+			if (missed_leader(lexer, lexer->inbuffer[i]))
+			    lexer->missed_leaders++;
+		}
+		lexer->inbuflen -= skip;
+		if (lexer->inbuflen == 0)
+		    lexer->inbuffer = lexer->inbufstore;
+		else
+		    lexer->inbuffer += skip;
+		lexer->inbufptr = lexer->inbuffer;
+		lexer->char_counter += skip;
+#ifdef STASH_ENABLE
+		lexer->stashbuflen = 0;
+#endif /* STASH_ENABLE */
+		gpsd_log(&lexer->errout, LOG_RAW + 1,
+			 "%zu characters discarded, %zu left\n",
+			 skip, lexer->inbuflen);
+		continue;
+	    }
+	}
+#ifdef NMEA0183_ENABLE
+	/* take a sentence body in one step, stop at anything unusual */
+	if (lexer->state == NMEA_LEADER_END) {
+	    size_t run = (size_t)packet_buffered_input(lexer);
+
+	    if (run > MAX_PACKET_SPAN - packet_span(lexer))
+		run = MAX_PACKET_SPAN - packet_span(lexer);
+	    run = nmea_body_scan(lexer->inbufptr, run);
+
+	    if (run > 0) {
+		lexer->inbufptr += run;
+		lexer->char_counter += run;
+		gpsd_log(&lexer->errout, LOG_RAW + 2,
+			 "%08ld: %zu characters, %s\n",
+			 lexer->char_counter, run, state_table[lexer->state]);
+		continue;
+	    }
+	}
+#endif /* NMEA0183_ENABLE */
+	c = *lexer->inbufptr++;
 	if (!nextstate(lexer, c))
 	    continue;
 	gpsd_log(&lexer->errout, LOG_RAW + 2,
@@ -1765,24 +1914,29 @@ void packet_parse(struct gps_lexer_t *lexer)
 	     */
 	    if (!str_starts_with((const char *)lexer->inbuffer, "$PASHR,"))
 	    {
+		static const char hexdigits[] = "0123456789ABCDEF";
 		bool checksum_ok = true;
 		char csum[3] = { '0', '0', '0' };
-		char *end;
+		unsigned char *end;
 		/*
 		 * Back up past any whitespace.  Need to do this because
 		 * at least one GPS (the Firefly 1a) emits \r\r\n
 		 */
-		for (end = (char *)lexer->inbufptr - 1; isspace((unsigned char) *end); end--)
+		for (end = lexer->inbufptr - 1; isspace(*end); end--)
 		    continue;
-		while (strchr("0123456789ABCDEF", *end))
+		while (isdigit(*end) || (*end >= 'A' && *end <= 'F'))
 		    --end;
 		if (*end == '*') {
-		    unsigned int n, crc = 0;
-		    for (n = 1; (char *)lexer->inbuffer + n < end; n++)
-			crc ^= lexer->inbuffer[n];
-		    (void)snprintf(csum, sizeof(csum), "%02X", crc);
-		    checksum_ok = (csum[0] == toupper((unsigned char) end[1])
-				   && csum[1] == toupper((unsigned char) end[2]));
+		    unsigned int crc = 0;
+
+		    if (end > lexer->inbuffer + 1)
+			crc = nmea_xor(lexer->inbuffer + 1,
+				       (size_t)(end - lexer->inbuffer - 1));
+		    csum[0] = hexdigits[crc >> 4];
+		    csum[1] = hexdigits[crc & 0x0f];
+		    csum[2] = '\0';
+		    checksum_ok = (csum[0] == toupper(end[1])
+				   && csum[1] == toupper(end[2]));
 		}
 		if (!checksum_ok) {
 		    gpsd_log(&lexer->errout, LOG_WARN,
@@ -2193,6 +2347,9 @@ void packet_parse(struct gps_lexer_t *lexer)
 	    if (crc24q_check(lexer->inbuffer,
 			     lexer->inbufptr - lexer->inbuffer)) {
 		packet_accept(lexer, RTCM3_PACKET);
+	    } else if (packet_span(lexer) >= MAX_PACKET_SPAN) {
+		packet_resync(lexer);
+		continue;
 	    } else {
 		gpsd_log(&lexer->errout, LOG_IO,
 			 "RTCM3 data checksum failure, "
@@ -2231,19 +2388,18 @@ void packet_parse(struct gps_lexer_t *lexer)
 #ifdef UBLOX_ENABLE
 	else if (lexer->state == UBX_RECOGNIZED) {
 	    /* UBX use a TCP like checksum */
-	    int n, len;
-	    unsigned char ck_a = (unsigned char)0;
-	    unsigned char ck_b = (unsigned char)0;
+	    int len;
+	    unsigned char ck_a, ck_b;
 	    len = lexer->inbufptr - lexer->inbuffer;
 	    gpsd_log(&lexer->errout, LOG_IO, "UBX: len %d\n", len);
-	    for (n = 2; n < (len - 2); n++) {
-		ck_a += lexer->inbuffer[n];
-		ck_b += ck_a;
-	    }
+	    ubx_checksum(lexer->inbuffer + 2, (size_t)(len - 4), &ck_a, &ck_b);
 	    if (ck_a == lexer->inbuffer[len - 2] &&
 		ck_b == lexer->inbuffer[len - 1])
 		packet_accept(lexer, UBX_PACKET);
-	    else {
+	    else if (packet_span(lexer) >= MAX_PACKET_SPAN) {
+		packet_resync(lexer);
+		continue;
+	    } else {
 		gpsd_log(&lexer->errout, LOG_IO,
 			 "UBX checksum 0x%02hhx%02hhx over length %d,"
 			 " expecting 0x%02hhx%02hhx (type 0x%02hhx%02hhx)\n",
@@ -2402,6 +2558,9 @@ void packet_parse(struct gps_lexer_t *lexer)
 			     "Accept GREIS packet type '%c%c' len %d\n",
 			     lexer->inbuffer[0], lexer->inbuffer[1], len);
 		    packet_accept(lexer, GREIS_PACKET);
+		} else if (packet_span(lexer) >= MAX_PACKET_SPAN) {
+		    packet_resync(lexer);
+		    continue;
 		} else {
 		    /*
 		     * Print hex instead of raw characters, since they might be
@@ -2471,14 +2630,56 @@ void packet_parse(struct gps_lexer_t *lexer)
 
 #undef getword
 
+static void packet_parse_buffered(struct gps_lexer_t *lexer)
+/* packet_parse(), giving up on packets in progress that run too long */
+{
+    /* coverity[tainted_data] */
+    packet_parse(lexer);
+
+    /* if a packet in progress has outgrown any real one, discard */
+    while (lexer->outbuflen == 0 && packet_span(lexer) >= span_limit(lexer)) {
+	lexer->overruns++;
+	gpsd_log(&lexer->errout, LOG_IO,
+		 "packet in state %s overran %zu chars, discarded (%lu)\n",
+		 state_table[lexer->state], packet_span(lexer),
+		 lexer->overruns);
+	/* coverity[tainted_data] */
+	packet_discard(lexer);
+	lexer->state = GROUND_STATE;
+	/* coverity[tainted_data] */
+	packet_parse(lexer);
+    }
+}
+
 ssize_t packet_get(int fd, struct gps_lexer_t *lexer)
 /* grab a packet; return -1=>I/O error, 0=>EOF, or a length */
 {
     ssize_t recvd;
 
+    /*
+     * A single read often brings in several packets (a whole GSV set,
+     * say), so hand out whatever is already complete before asking
+     * the device for more.  Besides saving a read() per packet, this
+     * keeps a big read from being topped up, and the store slid down,
+     * for every packet in it.
+     */
+    if (lexer->prefetched == 0 && packet_buffered_input(lexer) > 0) {
+	packet_parse_buffered(lexer);
+	if (lexer->outbuflen > 0)
+	    return (ssize_t)lexer->outbuflen;
+	/* only a fragment, or line noise, so go read some more */
+    }
+
     errno = 0;
-    recvd = read(fd, lexer->inbuffer + lexer->inbuflen,
-		 sizeof(lexer->inbuffer) - (lexer->inbuflen));
+    if (lexer->prefetched > 0) {
+	/* the daemon already read this into the buffer for us */
+	recvd = (ssize_t)lexer->prefetched;
+	lexer->prefetched = 0;
+    } else {
+	size_t room = packet_space(lexer);
+
+	recvd = read(fd, lexer->inbuffer + lexer->inbuflen, room);
+    }
     if (recvd == -1) {
 	if ((errno == EAGAIN) || (errno == EINTR)) {
 	    gpsd_log(&lexer->errout, LOG_RAW + 2, "no bytes ready\n");
@@ -2513,15 +2714,7 @@ ssize_t packet_get(int fd, struct gps_lexer_t *lexer)
 	return recvd;
 
     /* Otherwise, consume from the packet input buffer */
-    /* coverity[tainted_data] */
-    packet_parse(lexer);
-
-    /* if input buffer is full, discard */
-    if (sizeof(lexer->inbuffer) == (lexer->inbuflen)) {
-	/* coverity[tainted_data] */
-	packet_discard(lexer);
-	lexer->state = GROUND_STATE;
-    }
+    packet_parse_buffered(lexer);
 
     /*
      * If we gathered a packet, return its length; it will have been
@@ -2552,13 +2745,79 @@ ssize_t packet_get(int fd, struct gps_lexer_t *lexer)
 	return recvd;
 }
 
+size_t packet_frames(struct gps_lexer_t *lexer,
+		     struct gps_frame_t *frames, size_t maxframes)
+/*
+ * Pull every complete packet out of what is already buffered, without
+ * reading; return how many were stored.  The spans point into the
+ * input store, or for the last one possibly at outbuffer, and stay
+ * valid until the next packet_get() or packet_frames() on this lexer.
+ */
+{
+    size_t n = 0;
+
+    while (n < maxframes && packet_buffered_input(lexer) > 0) {
+	packet_parse_buffered(lexer);
+	if (lexer->outbuflen == 0)
+	    break;
+	frames[n].type = lexer->type;
+	frames[n].data = lexer->frame;
+	frames[n].len = lexer->outbuflen;
+	/* a stash put back over the packet leaves only outbuffer's copy */
+	if (frames[n++].data == lexer->outbuffer)
+	    break;
+    }
+    return n;
+}
+
+size_t packet_space(struct gps_lexer_t *lexer)
+/* room to read into after the input window, sliding it down if short */
+{
+    unsigned char *end = lexer->inbufstore + sizeof(lexer->inbufstore);
+    size_t room = end - (lexer->inbuffer + lexer->inbuflen);
+
+    /*
+     * Packets are consumed by moving the window start, not by moving
+     * data, so only copy the unconsumed tail down once the window has
+     * crept past the middle of the store.
+     */
+    if (lexer->inbuffer > lexer->inbufstore
+	&& room < sizeof(lexer->inbufstore) / 2) {
+	size_t offset = lexer->inbufptr - lexer->inbuffer;
+
+	memmove(lexer->inbufstore, lexer->inbuffer, lexer->inbuflen);
+	lexer->inbuffer = lexer->inbufstore;
+	lexer->inbufptr = lexer->inbuffer + offset;
+	room = sizeof(lexer->inbufstore) - lexer->inbuflen;
+    }
+    return room;
+}
+
+void packet_typemask(struct gps_lexer_t *lexer, unsigned int typemask)
+/* hunt only for the given packet types, or for everything if 0 */
+{
+    size_t i;
+
+    /* comments are cheap to recognize and the regression logs need them */
+    if (typemask != 0)
+	typemask |= PACKET_TYPEMASK(COMMENT_PACKET);
+    lexer->typemask = typemask;
+    lexer->missed_leaders = 0;
+    lexer->nleaders = 0;
+    for (i = 0; i < sizeof(ground_leaders) / sizeof(ground_leaders[0]); i++)
+	if (typemask == 0 || (ground_leaders[i].types & typemask) != 0)
+	    lexer->leaders[lexer->nleaders++] = ground_leaders[i].c;
+}
+
 void packet_reset(struct gps_lexer_t *lexer)
 /* return the packet machine to the ground state */
 {
+    packet_typemask(lexer, 0);
     lexer->type = BAD_PACKET;
     lexer->state = GROUND_STATE;
     lexer->inbuflen = 0;
-    lexer->inbufptr = lexer->inbuffer;
+    lexer->prefetched = 0;
+    lexer->inbufptr = lexer->inbuffer = lexer->inbufstore;
 #ifdef BINARY_ENABLE
     isgps_init(lexer);
 #endif /* BINARY_ENABLE */
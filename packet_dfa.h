@@ -0,0 +1,1191 @@
+/* packet_dfa.h - generated from packet_states.h by packet_dfa.py, do not hand-hack */
+
+#define DFA_CLASSES	32
+
+static const unsigned char dfa_class[256] = {
+     0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  2,  1,  1,  3,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     4,  5,  4,  6,  7,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     4,  8,  9, 10, 11, 12, 13, 14, 15, 16, 13, 13, 17, 13, 18, 13,
+    19, 20, 21, 22, 23, 13, 13, 24, 25, 26, 27,  4,  4,  4,  4,  4,
+     4, 13, 13, 28, 13, 13, 13, 13, 13, 13, 13, 29, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 30,  4,  4,  4,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1, 31,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+};
+
+static const unsigned short dfa_table[][DFA_CLASSES] = {
+    [COMMENT_BODY] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_GOTO(COMMENT_RECOGNIZED),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_GOTO(COMMENT_BODY),	/* 39 others, SP... */
+	DFA_GOTO(COMMENT_BODY),	/* '!' */
+	DFA_GOTO(COMMENT_BODY),	/* '#' */
+	DFA_GOTO(COMMENT_BODY),	/* '$' */
+	DFA_GOTO(COMMENT_BODY),	/* 'A' */
+	DFA_GOTO(COMMENT_BODY),	/* 'B' */
+	DFA_GOTO(COMMENT_BODY),	/* 'C' */
+	DFA_GOTO(COMMENT_BODY),	/* 'D' */
+	DFA_GOTO(COMMENT_BODY),	/* 'E' */
+	DFA_GOTO(COMMENT_BODY),	/* 31 others, 'F'... */
+	DFA_GOTO(COMMENT_BODY),	/* 'G' */
+	DFA_GOTO(COMMENT_BODY),	/* 'H' */
+	DFA_GOTO(COMMENT_BODY),	/* 'I' */
+	DFA_GOTO(COMMENT_BODY),	/* 'L' */
+	DFA_GOTO(COMMENT_BODY),	/* 'N' */
+	DFA_GOTO(COMMENT_BODY),	/* 'P' */
+	DFA_GOTO(COMMENT_BODY),	/* 'Q' */
+	DFA_GOTO(COMMENT_BODY),	/* 'R' */
+	DFA_GOTO(COMMENT_BODY),	/* 'S' */
+	DFA_GOTO(COMMENT_BODY),	/* 'T' */
+	DFA_GOTO(COMMENT_BODY),	/* 'W' */
+	DFA_GOTO(COMMENT_BODY),	/* 'X' */
+	DFA_GOTO(COMMENT_BODY),	/* 'Y' */
+	DFA_GOTO(COMMENT_BODY),	/* 'Z' */
+	DFA_GOTO(COMMENT_BODY),	/* 'c' */
+	DFA_GOTO(COMMENT_BODY),	/* 'k' */
+	DFA_GOTO(COMMENT_BODY),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_DOLLAR] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(SIRF_ACK_LEAD_1),	/* 'A' */
+	DFA_GOTO(BEIDOU_LEAD_1),	/* 'B' */
+#if defined(OCEANSERVER_ENABLE)
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+#else
+	DFA_RESYNC(GROUND_STATE),	/* 'C' */
+#endif
+	DFA_RESYNC(GROUND_STATE),	/* 'D' */
+	DFA_GOTO(ECDIS_LEAD_1),	/* 'E' */
+	DFA_RESYNC(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_PUB_LEAD),	/* 'G' */
+	DFA_GOTO(HEADCOMP_LEAD_1),	/* 'H' */
+	DFA_GOTO(SEATALK_LEAD_1),	/* 'I' */
+	DFA_RESYNC(GROUND_STATE),	/* 'L' */
+	DFA_RESYNC(GROUND_STATE),	/* 'N' */
+	DFA_GOTO(NMEA_VENDOR_LEAD),	/* 'P' */
+	DFA_GOTO(QZSS_LEAD_1),	/* 'Q' */
+	DFA_RESYNC(GROUND_STATE),	/* 'R' */
+	DFA_GOTO(SOUNDER_LEAD_1),	/* 'S' */
+	DFA_GOTO(TURN_LEAD_1),	/* 'T' */
+	DFA_GOTO(WEATHER_LEAD_1),	/* 'W' */
+	DFA_RESYNC(GROUND_STATE),	/* 'X' */
+	DFA_GOTO(TRANSDUCER_LEAD_1),	/* 'Y' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Z' */
+	DFA_RESYNC(GROUND_STATE),	/* 'c' */
+	DFA_RESYNC(GROUND_STATE),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_BANG] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_GOTO(AIS_LEAD_1),	/* 'A' */
+	DFA_GOTO(AIS_LEAD_ALT1),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_GOTO(AIS_LEAD_ALT3),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_PUB_LEAD] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_RESYNC(GROUND_STATE),	/* 'C' */
+	DFA_RESYNC(GROUND_STATE),	/* 'D' */
+	DFA_RESYNC(GROUND_STATE),	/* 'E' */
+	DFA_RESYNC(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RESYNC(GROUND_STATE),	/* 'G' */
+	DFA_RESYNC(GROUND_STATE),	/* 'H' */
+	DFA_RESYNC(GROUND_STATE),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Q' */
+	DFA_RESYNC(GROUND_STATE),	/* 'R' */
+	DFA_RESYNC(GROUND_STATE),	/* 'S' */
+	DFA_RESYNC(GROUND_STATE),	/* 'T' */
+	DFA_RESYNC(GROUND_STATE),	/* 'W' */
+	DFA_RESYNC(GROUND_STATE),	/* 'X' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Y' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Z' */
+	DFA_RESYNC(GROUND_STATE),	/* 'c' */
+	DFA_RESYNC(GROUND_STATE),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_VENDOR_LEAD] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_PASHR_A),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_LEADER_END] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_GOTO(NMEA_RECOGNIZED),	/* LF */
+	DFA_GOTO(NMEA_CR),	/* CR */
+	DFA_GOTO(NMEA_LEADER_END),	/* 39 others, SP... */
+	DFA_GOTO(NMEA_LEADER_END),	/* '!' */
+	DFA_GOTO(NMEA_LEADER_END),	/* '#' */
+#if defined(STASH_ENABLE)
+	DFA_RESYNC(STASH_RECOGNIZED),	/* '$' */
+#else
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+#endif
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_GOTO(NMEA_LEADER_END),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_PASHR_A] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_PASHR_S),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_PASHR_S] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_PASHR_H),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_PASHR_H] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RESYNC(GROUND_STATE),	/* LF */
+	DFA_RESYNC(GROUND_STATE),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_BINARY_BODY] = {
+	DFA_GOTO(NMEA_BINARY_BODY),	/* NUL */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 157 others, 0x01... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* LF */
+	DFA_GOTO(NMEA_BINARY_CR),	/* CR */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 39 others, SP... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '!' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '#' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '$' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'A' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'B' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'C' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'D' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'E' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'G' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'H' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'I' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'L' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'N' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'P' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Q' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'R' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'S' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'T' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'W' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'X' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Y' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Z' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'c' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'k' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '{' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_BINARY_CR] = {
+	DFA_GOTO(NMEA_BINARY_BODY),	/* NUL */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 157 others, 0x01... */
+	DFA_GOTO(NMEA_BINARY_NL),	/* LF */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* CR */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 39 others, SP... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '!' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '#' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '$' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'A' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'B' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'C' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'D' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'E' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'G' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'H' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'I' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'L' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'N' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'P' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Q' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'R' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'S' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'T' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'W' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'X' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Y' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Z' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'c' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'k' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '{' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_BINARY_NL] = {
+	DFA_GOTO(NMEA_BINARY_BODY),	/* NUL */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 157 others, 0x01... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* LF */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* CR */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 39 others, SP... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '!' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '#' */
+	DFA_RESYNC(NMEA_RECOGNIZED),	/* '$' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'A' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'B' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'C' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'D' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'E' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'G' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'H' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'I' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'L' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'N' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'P' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Q' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'R' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'S' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'T' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'W' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'X' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Y' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'Z' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'c' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 'k' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* '{' */
+	DFA_GOTO(NMEA_BINARY_BODY),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_CR] = {
+	DFA_RESYNC(GROUND_STATE),	/* NUL */
+	DFA_RESYNC(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_GOTO(NMEA_RECOGNIZED),	/* LF */
+	DFA_GOTO(NMEA_CR),	/* CR */
+	DFA_RESYNC(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RESYNC(GROUND_STATE),	/* '!' */
+	DFA_RESYNC(GROUND_STATE),	/* '#' */
+	DFA_RESYNC(GROUND_STATE),	/* '$' */
+	DFA_RESYNC(GROUND_STATE),	/* 'A' */
+	DFA_RESYNC(GROUND_STATE),	/* 'B' */
+	DFA_RESYNC(GROUND_STATE),	/* 'C' */
+	DFA_RESYNC(GROUND_STATE),	/* 'D' */
+	DFA_RESYNC(GROUND_STATE),	/* 'E' */
+	DFA_RESYNC(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RESYNC(GROUND_STATE),	/* 'G' */
+	DFA_RESYNC(GROUND_STATE),	/* 'H' */
+	DFA_RESYNC(GROUND_STATE),	/* 'I' */
+	DFA_RESYNC(GROUND_STATE),	/* 'L' */
+	DFA_RESYNC(GROUND_STATE),	/* 'N' */
+	DFA_RESYNC(GROUND_STATE),	/* 'P' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Q' */
+	DFA_RESYNC(GROUND_STATE),	/* 'R' */
+	DFA_RESYNC(GROUND_STATE),	/* 'S' */
+	DFA_RESYNC(GROUND_STATE),	/* 'T' */
+	DFA_RESYNC(GROUND_STATE),	/* 'W' */
+	DFA_RESYNC(GROUND_STATE),	/* 'X' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Y' */
+	DFA_RESYNC(GROUND_STATE),	/* 'Z' */
+	DFA_RESYNC(GROUND_STATE),	/* 'c' */
+	DFA_RESYNC(GROUND_STATE),	/* 'k' */
+	DFA_RESYNC(GROUND_STATE),	/* '{' */
+	DFA_RESYNC(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [NMEA_RECOGNIZED] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_GOTO(NMEA_BANG),	/* '!' */
+	DFA_GOTO(COMMENT_BODY),	/* '#' */
+	DFA_GOTO(NMEA_DOLLAR),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+#if defined(PASSTHROUGH_ENABLE)
+	DFA_RETRY(JSON_LEADER),	/* '{' */
+#else
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+#endif
+#if defined(UBLOX_ENABLE)
+	DFA_GOTO(UBX_LEADER_1),	/* 0xb5 */
+#else
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+#endif
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [SIRF_ACK_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_GOTO(SIRF_ACK_LEAD_2),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [SIRF_ACK_LEAD_2] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_1] = {
+	DFA_GOTO(AIS_LEAD_2),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'R' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'S' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_GOTO(AIS_LEAD_2),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_2] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_ALT1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_GOTO(AIS_LEAD_ALT2),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_ALT2] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_ALT3] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_GOTO(AIS_LEAD_ALT4),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [AIS_LEAD_ALT4] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'A' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'E' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 31 others, 'F'... */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'G' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'P' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Q' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'R' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'S' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'c' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [SEATALK_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [WEATHER_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [HEADCOMP_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [TURN_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [ECDIS_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [SOUNDER_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+#if defined(SKYTRAQ_ENABLE)
+	DFA_GOTO(NMEA_LEADER_END),	/* 'T' */
+#else
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+#endif
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [TRANSDUCER_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [BEIDOU_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_RETRY(GROUND_STATE),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+
+#ifdef NMEA0183_ENABLE
+    [QZSS_LEAD_1] = {
+	DFA_RETRY(GROUND_STATE),	/* NUL */
+	DFA_RETRY(GROUND_STATE),	/* 157 others, 0x01... */
+	DFA_RETRY(GROUND_STATE),	/* LF */
+	DFA_RETRY(GROUND_STATE),	/* CR */
+	DFA_RETRY(GROUND_STATE),	/* 39 others, SP... */
+	DFA_RETRY(GROUND_STATE),	/* '!' */
+	DFA_RETRY(GROUND_STATE),	/* '#' */
+	DFA_RETRY(GROUND_STATE),	/* '$' */
+	DFA_RETRY(GROUND_STATE),	/* 'A' */
+	DFA_RETRY(GROUND_STATE),	/* 'B' */
+	DFA_RETRY(GROUND_STATE),	/* 'C' */
+	DFA_RETRY(GROUND_STATE),	/* 'D' */
+	DFA_RETRY(GROUND_STATE),	/* 'E' */
+	DFA_RETRY(GROUND_STATE),	/* 31 others, 'F'... */
+	DFA_RETRY(GROUND_STATE),	/* 'G' */
+	DFA_RETRY(GROUND_STATE),	/* 'H' */
+	DFA_RETRY(GROUND_STATE),	/* 'I' */
+	DFA_RETRY(GROUND_STATE),	/* 'L' */
+	DFA_RETRY(GROUND_STATE),	/* 'N' */
+	DFA_RETRY(GROUND_STATE),	/* 'P' */
+	DFA_RETRY(GROUND_STATE),	/* 'Q' */
+	DFA_RETRY(GROUND_STATE),	/* 'R' */
+	DFA_RETRY(GROUND_STATE),	/* 'S' */
+	DFA_RETRY(GROUND_STATE),	/* 'T' */
+	DFA_RETRY(GROUND_STATE),	/* 'W' */
+	DFA_RETRY(GROUND_STATE),	/* 'X' */
+	DFA_RETRY(GROUND_STATE),	/* 'Y' */
+	DFA_GOTO(NMEA_LEADER_END),	/* 'Z' */
+	DFA_RETRY(GROUND_STATE),	/* 'c' */
+	DFA_RETRY(GROUND_STATE),	/* 'k' */
+	DFA_RETRY(GROUND_STATE),	/* '{' */
+	DFA_RETRY(GROUND_STATE),	/* 0xb5 */
+    },
+#endif /* NMEA0183_ENABLE */
+};
+
+/* end of packet_dfa.h */
@@ -0,0 +1,319 @@
+#!/usr/bin/env python
+#
+# This file is Copyright (c) 2019 by the GPSD project
+# SPDX-License-Identifier: BSD-2-clause
+#
+# Generate packet_dfa.h, the transition table for the side-effect-free
+# framing states of the packet lexer in packet.c.
+#
+# The rules below say what each table-driven state does with each input
+# byte; the first rule that matches wins.  packet_states.h is read for
+# the state names and for the #if conditions each state lives under, so
+# every generated row is compiled in exactly when its state is.  Bytes
+# that every rule treats alike are folded into one character class, so
+# a row is a handful of entries rather than 256.
+#
+# States with length counting, checksums or the RTCM2 decoder stay in
+# the switch in nextstate(); only rows for the states listed here are
+# generated, and a state must not be in both places.
+#
+# Usage: packet_dfa.py packet_states.h >packet_dfa.h
+
+# This code runs compatibly under Python 2 and 3.x for x >= 2.
+# Preserve this property!
+from __future__ import absolute_import, print_function, division
+
+import re
+import sys
+
+# what an entry does; these match the DFA_* macros in packet.c
+GOTO = "DFA_GOTO"       # consume the byte, go to the state
+RETRY = "DFA_RETRY"     # push the byte back and rescan it in the state
+RESYNC = "DFA_RESYNC"   # push the byte back, go to the state, carry on
+STAY = None             # consume the byte, stay put
+
+# byte sets, as the C locale sees them
+PRINT = frozenset(range(0x20, 0x7f))
+ALPHA = frozenset(list(range(ord('A'), ord('Z') + 1)) +
+                  list(range(ord('a'), ord('z') + 1)))
+ANY = frozenset(range(256))
+
+
+def chars(s):
+    "Byte set of the characters in a string."
+    return frozenset(ord(c) for c in s)
+
+
+def but(s):
+    "Complement of a byte set."
+    return ANY - s
+
+
+# state: [(bytes, action, next state, #if condition or None), ...]
+# RETRY is for where nextstate() would return character_pushback(),
+# RESYNC for where it would ignore what that returned.
+NMEA_LEAD_ONLY = [
+    # second leader character of the various talker IDs
+    ("SEATALK_LEAD_1", "IN"),
+    ("WEATHER_LEAD_1", "I"),
+    ("HEADCOMP_LEAD_1", "C"),
+    ("TURN_LEAD_1", "I"),
+    ("ECDIS_LEAD_1", "C"),
+    ("TRANSDUCER_LEAD_1", "X"),
+    ("BEIDOU_LEAD_1", "D"),
+    ("QZSS_LEAD_1", "Z"),
+]
+
+RULES = {
+    "COMMENT_BODY": [
+        (chars("\n"), GOTO, "COMMENT_RECOGNIZED", None),
+        (but(PRINT), RETRY, "GROUND_STATE", None),
+        (ANY, STAY, None, None),
+    ],
+    "NMEA_DOLLAR": [
+        (chars("G"), GOTO, "NMEA_PUB_LEAD", None),
+        (chars("P"), GOTO, "NMEA_VENDOR_LEAD", None),
+        (chars("I"), GOTO, "SEATALK_LEAD_1", None),
+        (chars("W"), GOTO, "WEATHER_LEAD_1", None),
+        (chars("H"), GOTO, "HEADCOMP_LEAD_1", None),
+        (chars("T"), GOTO, "TURN_LEAD_1", None),
+        (chars("A"), GOTO, "SIRF_ACK_LEAD_1", None),
+        (chars("E"), GOTO, "ECDIS_LEAD_1", None),
+        (chars("S"), GOTO, "SOUNDER_LEAD_1", None),
+        (chars("Y"), GOTO, "TRANSDUCER_LEAD_1", None),
+        (chars("B"), GOTO, "BEIDOU_LEAD_1", None),
+        (chars("Q"), GOTO, "QZSS_LEAD_1", None),
+        (chars("C"), GOTO, "NMEA_LEADER_END", "defined(OCEANSERVER_ENABLE)"),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    # $GP == GPS, $GL = GLONASS only, $GN = mixed GPS and GLONASS,
+    # according to NMEA (IEIC 61162-1) DRAFT 02/06/2009.  We have a
+    # log from China with a Beidou device using $GB rather than $BD.
+    "NMEA_PUB_LEAD": [
+        (chars("BPNLA"), GOTO, "NMEA_LEADER_END", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    "NMEA_VENDOR_LEAD": [
+        (chars("A"), GOTO, "NMEA_PASHR_A", None),
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    # Without the following six states, DLE in a $PASHR can fool the
+    # sniffer into thinking it sees a TSIP packet.  Hilarity ensues.
+    "NMEA_PASHR_A": [
+        (chars("S"), GOTO, "NMEA_PASHR_S", None),
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    "NMEA_PASHR_S": [
+        (chars("H"), GOTO, "NMEA_PASHR_H", None),
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    "NMEA_PASHR_H": [
+        (chars("R"), GOTO, "NMEA_BINARY_BODY", None),
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    "NMEA_BINARY_BODY": [
+        (chars("\r"), GOTO, "NMEA_BINARY_CR", None),
+        (ANY, STAY, None, None),
+    ],
+    "NMEA_BINARY_CR": [
+        (chars("\n"), GOTO, "NMEA_BINARY_NL", None),
+        (ANY, GOTO, "NMEA_BINARY_BODY", None),
+    ],
+    "NMEA_BINARY_NL": [
+        (chars("$"), RESYNC, "NMEA_RECOGNIZED", None),
+        (ANY, GOTO, "NMEA_BINARY_BODY", None),
+    ],
+    "NMEA_BANG": [
+        (chars("A"), GOTO, "AIS_LEAD_1", None),
+        (chars("B"), GOTO, "AIS_LEAD_ALT1", None),
+        (chars("S"), GOTO, "AIS_LEAD_ALT3", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    # strchr() used to match the terminating NUL as well
+    "AIS_LEAD_1": [
+        (chars("BDINRSTX\0"), GOTO, "AIS_LEAD_2", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "AIS_LEAD_2": [
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "AIS_LEAD_ALT1": [
+        (chars("S"), GOTO, "AIS_LEAD_ALT2", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "AIS_LEAD_ALT2": [
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "AIS_LEAD_ALT3": [
+        (chars("A"), GOTO, "AIS_LEAD_ALT4", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "AIS_LEAD_ALT4": [
+        (ALPHA, GOTO, "NMEA_LEADER_END", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "NMEA_LEADER_END": [
+        (chars("\r"), GOTO, "NMEA_CR", None),
+        # not strictly correct, but helps for interpreting logfiles
+        (chars("\n"), GOTO, "NMEA_RECOGNIZED", None),
+        (chars("$"), RESYNC, "STASH_RECOGNIZED", "defined(STASH_ENABLE)"),
+        (chars("$"), RESYNC, "GROUND_STATE", None),
+        (but(PRINT), RESYNC, "GROUND_STATE", None),
+        (ANY, STAY, None, None),
+    ],
+    # the Jackson Labs Firefly-1a emits \r\r\n
+    "NMEA_CR": [
+        (chars("\n"), GOTO, "NMEA_RECOGNIZED", None),
+        (chars("\r"), GOTO, "NMEA_CR", None),
+        (ANY, RESYNC, "GROUND_STATE", None),
+    ],
+    "NMEA_RECOGNIZED": [
+        (chars("#"), GOTO, "COMMENT_BODY", None),
+        (chars("$"), GOTO, "NMEA_DOLLAR", None),
+        (chars("!"), GOTO, "NMEA_BANG", None),
+        # LEA-5H can and will output NMEA and UBX back to back
+        (frozenset([0xb5]), GOTO, "UBX_LEADER_1", "defined(UBLOX_ENABLE)"),
+        (chars("{"), RETRY, "JSON_LEADER", "defined(PASSTHROUGH_ENABLE)"),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "SOUNDER_LEAD_1": [
+        (chars("D"), GOTO, "NMEA_LEADER_END", None),
+        (chars("T"), GOTO, "NMEA_LEADER_END", "defined(SKYTRAQ_ENABLE)"),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "SIRF_ACK_LEAD_1": [
+        (chars("c"), GOTO, "SIRF_ACK_LEAD_2", None),
+        (chars("I"), GOTO, "AIS_LEAD_2", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+    "SIRF_ACK_LEAD_2": [
+        (chars("k"), GOTO, "NMEA_LEADER_END", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ],
+}
+for (state, accept) in NMEA_LEAD_ONLY:
+    RULES[state] = [
+        (chars(accept), GOTO, "NMEA_LEADER_END", None),
+        (ANY, RETRY, "GROUND_STATE", None),
+    ]
+
+
+def read_states(path):
+    "Return [(state, [#if conditions it is under]), ...] in file order."
+    states = []
+    stack = []
+    for line in open(path):
+        line = line.strip()
+        if line.startswith("#if"):
+            stack.append(line)
+        elif line.startswith("#endif"):
+            stack.pop()
+        elif line.startswith("#"):
+            sys.stderr.write("packet_dfa.py: can't handle %s\n" % line)
+            sys.exit(1)
+        else:
+            m = re.match(r"([A-Z][A-Z0-9_]*),", line)
+            if m:
+                states.append((m.group(1), list(stack)))
+    return states
+
+
+def classes():
+    "Partition the bytes by how every rule treats them."
+    sig = {}
+    for b in range(256):
+        key = tuple(b in rule[0]
+                    for state in sorted(RULES) for rule in RULES[state])
+        sig.setdefault(key, []).append(b)
+    return sorted(sig.values())
+
+
+def describe(members):
+    "Short comment text for a character class."
+    def one(b):
+        if b == ord("'") or b == ord("\\"):
+            return "'\\%c'" % b
+        if 0x20 < b < 0x7f:
+            return "'%c'" % b
+        return {0: "NUL", 9: "TAB", 10: "LF", 13: "CR", 32: "SP"}.get(
+            b, "0x%02x" % b)
+    if len(members) <= 4:
+        return " ".join(one(b) for b in members)
+    return "%d others, %s..." % (len(members), one(members[0]))
+
+
+def entry(state, rule):
+    (_bytes, action, target, _guard) = rule
+    if action is STAY:
+        return "DFA_GOTO(%s)" % state
+    return "%s(%s)" % (action, target)
+
+
+def main(path):
+    states = read_states(path)
+    known = dict(states)
+    for state in RULES:
+        if state not in known:
+            sys.stderr.write("packet_dfa.py: no state %s in %s\n"
+                             % (state, path))
+            sys.exit(1)
+    parts = classes()
+    cls = [0] * 256
+    for (n, members) in enumerate(parts):
+        for b in members:
+            cls[b] = n
+
+    out = sys.stdout.write
+    out("/* packet_dfa.h - generated from packet_states.h by packet_dfa.py,"
+        " do not hand-hack */\n\n")
+    out("#define DFA_CLASSES\t%d\n\n" % len(parts))
+    out("static const unsigned char dfa_class[256] = {\n")
+    for row in range(0, 256, 16):
+        out("    " + " ".join("%2d," % c for c in cls[row:row + 16]) + "\n")
+    out("};\n\n")
+    out("static const unsigned short dfa_table[][DFA_CLASSES] = {\n")
+    first = True
+    for (state, guards) in states:
+        if state not in RULES:
+            continue
+        if not first:
+            out("\n")
+        first = False
+        for g in guards:
+            out(g + "\n")
+        out("    [%s] = {\n" % state)
+        for (n, members) in enumerate(parts):
+            b = members[0]
+            matches = [r for r in RULES[state] if b in r[0]]
+            comment = "\t/* %s */" % describe(members)
+            if matches[0][3] is None:
+                out("\t%s,%s\n" % (entry(state, matches[0]), comment))
+                continue
+            directive = "#if"
+            for rule in matches:
+                if rule[3] is None:
+                    out("#else\n\t%s,%s\n" % (entry(state, rule), comment))
+                    break
+                out("%s %s\n\t%s,%s\n"
+                    % (directive, rule[3], entry(state, rule), comment))
+                directive = "#elif"
+            out("#endif\n")
+        out("    },\n")
+        for g in reversed(guards):
+            out("#endif /* %s */\n" % g.split(None, 1)[1])
+    out("};\n\n/* end of packet_dfa.h */\n")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.stderr.write("usage: packet_dfa.py packet_states.h\n")
+        sys.exit(1)
+    main(sys.argv[1])
+
+# end
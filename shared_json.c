@@ -24,9 +24,12 @@ PERMISSIONS
 
 int json_device_read(const char *buf,
 		     struct devconfig_t *dev,
+		     char *protocols, size_t protocolslen,
 		     const char **endptr)
+/* protocols, if not NULL, gets the daemon-only "protocols" attribute */
 {
     char tbuf[JSON_DATE_MAX+1];
+    char pbuf[GPS_JSON_PROTOCOLS_MAX];
     /* *INDENT-OFF* */
     const struct json_attr_t json_attrs_device[] = {
 	{"class",      t_check,      .dflt.check = "DEVICE"},
@@ -55,15 +58,20 @@ int json_device_read(const char *buf,
 				        .dflt.real = NAN},
 	{"mincycle",   t_real,       .addr.real = &dev->mincycle,
 				        .dflt.real = NAN},
+	{"protocols",  t_string,     .addr.string  = pbuf,
+	                                .len = sizeof(pbuf)},
 	{NULL},
     };
     /* *INDENT-ON* */
     int status;
 
     tbuf[0] = '\0';
+    pbuf[0] = '\0';
     status = json_read_object(buf, json_attrs_device, endptr);
     if (status != 0)
 	return status;
+    if (protocols != NULL)
+	(void)strlcpy(protocols, pbuf, protocolslen);
 
     if (isfinite(dev->activated) == 0) {
 	if (tbuf[0] == '\0')
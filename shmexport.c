@@ -111,7 +111,7 @@ void shm_update(struct gps_context_t *context, struct gps_data_t *gpsdata)
 	 */
 	shared->bookend2 = tick;
 	memory_barrier();
-	shared->gpsdata = *gpsdata;
+	gps_data_copy((struct gps_data_t *)&shared->gpsdata, gpsdata);
 	memory_barrier();
 #ifndef USE_QT
 	shared->gpsdata.gps_fd = SHM_PSEUDO_FD;
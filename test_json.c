@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-clause
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -320,6 +321,17 @@ static const struct json_array_t json_array_Real = {
 };
 #endif /* JSON_MINIMAL */
 
+/* Case 21: test parsing of RAW message, and copying it */
+
+static const char *json_strRAW = "{\"class\":\"RAW\",\"device\":\"GPS#1\"," \
+    "\"time\":\"2018-10-09T17:43:56.000Z\",\"rawdata\":[" \
+    "{\"gnssid\":0,\"svid\":2,\"sigid\":0,\"snr\":44,\"locktime\":64500," \
+    "\"pseudorange\":21883367.4326,\"carrierphase\":114997807.519," \
+    "\"doppler\":-1536.90698242}," \
+    "{\"gnssid\":6,\"svid\":5,\"sigid\":0,\"snr\":38,\"locktime\":1200," \
+    "\"freqid\":3,\"pseudorange\":23456789.1,\"doppler\":812.5}]}";
+static struct gps_data_t rawcopy;
+
 /* *INDENT-ON* */
 
 static void jsontest(int i)
@@ -533,7 +545,11 @@ static void jsontest(int i)
 	break;
 
 #ifdef JSON_MINIMAL
-#define MAXTEST 17
+    case 18:
+    case 19:
+    case 20:
+	/* the array tests need the full parser */
+	break;
 #else
     case 18:
 	status = json_read_array(json_strInt, &json_array_Int, NULL);
@@ -562,9 +578,51 @@ static void jsontest(int i)
 	assert_real("realstore[3]", realstore[3], 0);
 	break;
 
-#define MAXTEST 20
 #endif /* JSON_MINIMAL */
 
+    case 21:
+	status = libgps_json_unpack(json_strRAW, &gpsdata, NULL);
+	assert_case(status);
+	assert_other("RAW_SET", (gpsdata.set & RAW_SET) != 0, 1);
+	assert_string("device", gpsdata.dev.path, "GPS#1");
+	assert_real("time", gpsdata.rawmeas.mtime, 1539107036.0);
+	assert_integer("nmeas", gpsdata.rawmeas.nmeas, 2);
+	assert_integer("meas[0].svid", gpsdata.rawmeas.meas[0].svid, 2);
+	assert_integer("meas[0].snr", gpsdata.rawmeas.meas[0].snr, 44);
+	assert_integer("meas[0].locktime", gpsdata.rawmeas.meas[0].locktime,
+		       64500);
+	assert_real("meas[0].carrierphase",
+		    gpsdata.rawmeas.meas[0].carrierphase, 114997807.519);
+	assert_integer("meas[0].satstat", gpsdata.rawmeas.meas[0].satstat,
+		       SAT_ACQUIRED | SAT_CODE_TRACK | SAT_CARR_TRACK);
+	assert_integer("meas[1].gnssid", gpsdata.rawmeas.meas[1].gnssid, 6);
+	assert_integer("meas[1].freqid", gpsdata.rawmeas.meas[1].freqid, 3);
+	assert_other("meas[1].carrierphase",
+		     isfinite(gpsdata.rawmeas.meas[1].carrierphase) != 0, 0);
+	assert_real("meas[1].doppler", gpsdata.rawmeas.meas[1].doppler, 812.5);
+	/* the copy carries the valid measurements but nothing past them */
+	memset(&rawcopy, 0, sizeof(rawcopy));
+	rawcopy.rawmeas.meas[2].svid = 99;
+	gps_data_copy(&rawcopy, &gpsdata);
+	assert_integer("copy nmeas", rawcopy.rawmeas.nmeas, 2);
+	assert_integer("copy meas[1].svid", rawcopy.rawmeas.meas[1].svid, 5);
+	assert_integer("copy meas[2].svid", rawcopy.rawmeas.meas[2].svid, 99);
+	/* privdata lies past the union, and still comes along */
+	gpsdata.privdata = &rawcopy;
+	rawcopy.privdata = NULL;
+	gps_data_copy(&rawcopy, &gpsdata);
+	assert_other("copy privdata", rawcopy.privdata == &rawcopy, 1);
+	gpsdata.privdata = NULL;
+	/* any other report is copied whole, stale measurements and all */
+	gpsdata.set = (gpsdata.set & ~UNION_SET) | TOFF_SET;
+	memset(&rawcopy, 0xa5, sizeof(rawcopy));
+	gps_data_copy(&rawcopy, &gpsdata);
+	assert_other("full copy",
+		     memcmp(&rawcopy, &gpsdata, sizeof(rawcopy)) == 0, 1);
+	break;
+
+#define MAXTEST 21
+
     default:
 	(void)fputs("Unknown test number\n", stderr);
 	exit(EXIT_FAILURE);
@@ -9,9 +9,12 @@
 #include <ctype.h>
 #include <sys/types.h>
 #include <fcntl.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "gpsd.h"
+#include "crc24q.h"
+#include "driver_greis.h"
 
 static int verbose = 0;
 
@@ -275,7 +278,7 @@ static int packet_test(struct map *mp)
 	printf("%2ti: %s test FAILED (packet type %d wrong).\n",
 	       mp - singletests + 1, mp->legend, lexer.type);
     else if (memcmp
-	     (mp->test + mp->garbage_offset, lexer.outbuffer,
+	     (mp->test + mp->garbage_offset, lexer.frame,
 	      lexer.outbuflen)) {
 	printf("%2ti: %s test FAILED (data garbled).\n", mp - singletests + 1,
 	       mp->legend);
@@ -304,6 +307,528 @@ static void runon_test(struct map *mp)
     } while (st > 0);
 }
 
+static int frames_test(struct map *mp)
+/* all the complete packets in a buffer should come out in one pass */
+{
+    struct gps_lexer_t lexer;
+    struct gps_frame_t frames[4];
+    size_t i, n;
+    int failure = 0;
+
+    lexer_init(&lexer);
+    lexer.errout.debug = verbose;
+    memcpy(lexer.inbufptr = lexer.inbuffer, mp->test, mp->testlen);
+    lexer.inbuflen = mp->testlen;
+    n = packet_frames(&lexer, frames, sizeof(frames) / sizeof(frames[0]));
+    for (i = 0; i < n; i++) {
+	(void)printf("frame %zu: type %d, %zu bytes\n",
+		     i, frames[i].type, frames[i].len);
+	if (frames[i].type != mp->type
+	    || frames[i].data < lexer.inbufstore
+	    || frames[i].data + frames[i].len
+		> lexer.inbufstore + sizeof(lexer.inbufstore)) {
+	    (void)printf("%s test FAILED (bad frame).\n", mp->legend);
+	    ++failure;
+	}
+    }
+    if (n != 2 || frames[0].len + frames[1].len != mp->testlen
+	|| memcmp(frames[0].data, mp->test, mp->testlen) != 0) {
+	(void)printf("%s test FAILED (%zu frames).\n", mp->legend, n);
+	++failure;
+    }
+    return failure;
+}
+
+static int long_frame_test(void)
+/* a UBX packet over MAX_PACKET_LENGTH, arriving in pieces, must survive */
+{
+    static struct gps_lexer_t lexer;
+    static unsigned char buf[MAX_FRAME_LENGTH];
+    static const char nmea[] = "$GPVTG,308.74,T,,M,0.00,N,0.0,K*68\r\n";
+    size_t payload = 2000, len = 0, off, i;
+    unsigned char ck_a = 0, ck_b = 0;
+    int failure = 0, packets = 0;
+
+    memcpy(buf, nmea, sizeof(nmea) - 1);
+    len += sizeof(nmea) - 1;
+    buf[len++] = 0xb5;
+    buf[len++] = 0x62;
+    buf[len++] = 0x02;		/* RXM */
+    buf[len++] = 0x15;		/* RAWX */
+    buf[len++] = (unsigned char)(payload & 0xff);
+    buf[len++] = (unsigned char)(payload >> 8);
+    for (i = 0; i < payload; i++)
+	buf[len++] = (unsigned char)i;
+    for (i = sizeof(nmea) + 1; i < len; i++) {
+	ck_a += buf[i];
+	ck_b += ck_a;
+    }
+    buf[len++] = ck_a;
+    buf[len++] = ck_b;
+    memcpy(buf + len, nmea, sizeof(nmea) - 1);
+    len += sizeof(nmea) - 1;
+
+    lexer_init(&lexer);
+    lexer.errout.debug = verbose;
+    for (off = 0; off < len; off += 100) {
+	struct gps_frame_t frames[4];
+	size_t n = len - off < 100 ? len - off : 100;
+
+	(void)packet_space(&lexer);
+	memcpy(lexer.inbuffer + lexer.inbuflen, buf + off, n);
+	lexer.inbuflen += n;
+	n = packet_frames(&lexer, frames, sizeof(frames) / sizeof(frames[0]));
+	for (i = 0; i < n; i++)
+	    (void)printf("frame %d: type %d, %zu bytes\n",
+			 packets++, frames[i].type, frames[i].len);
+    }
+    (void)printf("%lu long, %lu overrun\n",
+		 lexer.long_frames, lexer.overruns);
+    if (packets != 3 || lexer.long_frames != 1 || lexer.overruns != 0) {
+	(void)puts("Long frame test FAILED.");
+	++failure;
+    }
+    return failure;
+}
+
+static int typemask_test(void)
+/* a lexer hunting only NMEA must skip UBX, but count the leaders */
+{
+    static struct gps_lexer_t lexer;
+    static const char nmea[] = "$GPVTG,308.74,T,,M,0.00,N,0.0,K*68\r\n";
+    /* UBX-ACK-ACK for CFG-MSG, after line noise */
+    static const unsigned char ubx[] = {
+	'\r', '\n', 0xb5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x01, 0x0f, 0x38,
+    };
+    int failure = 0, pass, nmeas, ubxs;
+
+    lexer_init(&lexer);
+    lexer.errout.debug = verbose;
+    for (pass = 0; pass < 2; pass++) {
+	struct gps_frame_t frames[8];
+	size_t n, i;
+
+	packet_typemask(&lexer, pass == 0 ? PACKET_TYPEMASK(NMEA_PACKET) : 0);
+	(void)packet_space(&lexer);
+	memcpy(lexer.inbuffer + lexer.inbuflen, nmea, sizeof(nmea) - 1);
+	lexer.inbuflen += sizeof(nmea) - 1;
+	memcpy(lexer.inbuffer + lexer.inbuflen, ubx, sizeof(ubx));
+	lexer.inbuflen += sizeof(ubx);
+	memcpy(lexer.inbuffer + lexer.inbuflen, nmea, sizeof(nmea) - 1);
+	lexer.inbuflen += sizeof(nmea) - 1;
+	n = packet_frames(&lexer, frames, sizeof(frames) / sizeof(frames[0]));
+	nmeas = ubxs = 0;
+	for (i = 0; i < n; i++)
+	    if (frames[i].type == NMEA_PACKET)
+		nmeas++;
+	    else if (frames[i].type == UBX_PACKET)
+		ubxs++;
+	(void)printf("%s: %d NMEA, %d UBX, %lu missed leaders\n",
+		     pass == 0 ? "NMEA only" : "all types",
+		     nmeas, ubxs, lexer.missed_leaders);
+	if (nmeas != 2 || ubxs != (pass == 0 ? 0 : 1)
+	    || (pass == 0) != (lexer.missed_leaders > 0)) {
+	    (void)puts("Typemask test FAILED.");
+	    ++failure;
+	}
+    }
+    return failure;
+}
+
+static int checksum_test(void)
+/* the fast CRC-24Q, GREIS and UBX kernels must agree with the plain sums */
+{
+    static unsigned char buf[1200];
+    unsigned int seed = 1, len, off, mismatches = 0, checks = 0;
+#ifdef UBLOX_ENABLE
+    /* UBX-ACK-ACK for CFG-MSG, checksum 0x0f 0x38 */
+    static const unsigned char ack[] = {0x05, 0x01, 0x02, 0x00, 0x06, 0x01};
+    unsigned char ck_a, ck_b;
+
+    ubx_checksum(ack, sizeof(ack), &ck_a, &ck_b);
+    checks++;
+    if (ck_a != 0x0f || ck_b != 0x38) {
+	if (verbose)
+	    (void)printf("UBX checksum %02x%02x, expecting 0f38\n",
+			 ck_a, ck_b);
+	mismatches++;
+    }
+#endif /* UBLOX_ENABLE */
+
+    for (len = 0; len < sizeof(buf); len++) {
+	seed = seed * 1103515245 + 12345;
+	buf[len] = (unsigned char)(seed >> 16);
+    }
+    for (off = 0; off < 8; off++)
+	for (len = 0; len + off <= sizeof(buf) - 8; len += (len < 64 ? 1 : 37)) {
+	    const unsigned char *p = buf + off;
+	    unsigned long crc = 0;
+	    unsigned char cs = 0;
+	    unsigned int i;
+	    int bit;
+#ifdef UBLOX_ENABLE
+	    unsigned char a = 0, b = 0;
+#endif /* UBLOX_ENABLE */
+
+	    /* CRC-24Q, polynomial 0x1864CFB, no reflection */
+	    for (i = 0; i < len; i++) {
+		crc ^= (unsigned long)p[i] << 16;
+		for (bit = 0; bit < 8; bit++) {
+		    crc <<= 1;
+		    if (crc & 0x1000000)
+			crc ^= 0x1864CFB;
+		}
+	    }
+	    for (i = 0; i < len; i++)
+		cs = (unsigned char)(((cs << 2) | (cs >> 6)) ^ p[i]);
+	    cs = (unsigned char)((cs << 2) | (cs >> 6));
+
+	    checks++;
+	    if (crc24q_hash(p, (int)len) != (unsigned)crc
+		|| greis_checksum(p, (int)len) != cs) {
+		if (verbose)
+		    (void)printf("checksum mismatch at offset %u, length %u\n",
+				 off, len);
+		mismatches++;
+	    }
+#ifdef UBLOX_ENABLE
+	    /* UBX 8-bit Fletcher, a byte at a time */
+	    for (i = 0; i < len; i++) {
+		a += p[i];
+		b += a;
+	    }
+	    ubx_checksum(p, len, &ck_a, &ck_b);
+	    checks++;
+	    if (ck_a != a || ck_b != b) {
+		if (verbose)
+		    (void)printf("UBX checksum mismatch at offset %u, "
+				 "length %u\n", off, len);
+		mismatches++;
+	    }
+#endif /* UBLOX_ENABLE */
+	}
+    (void)printf("%u checks, %u mismatches\n", checks, mismatches);
+    if (mismatches > 0) {
+	(void)puts("Checksum test FAILED.");
+	return 1;
+    }
+    return 0;
+}
+
+/*
+ * Lexer benchmark.  Everything is loaded and sorted into memory before
+ * the clock starts, so the timed loops do nothing but copy input into
+ * the lexer a read's worth at a time and collect packets, as the
+ * daemon would; neither side allocates.  With a protocol selected only
+ * that protocol's packets are timed, and for NMEA the sentence decoder
+ * is timed as well.
+ */
+#define BENCH_CHUNK	4096	/* bytes per simulated read() */
+#define BENCH_SYNTH	(1024 * 1024)	/* size of each synthetic input */
+
+static const char *bench_names[] = {
+    [COMMENT_PACKET] = "COMMENT",
+    [NMEA_PACKET] = "NMEA",
+    [AIVDM_PACKET] = "AIVDM",
+    [GARMINTXT_PACKET] = "GARMINTXT",
+    [SIRF_PACKET] = "SIRF",
+    [ZODIAC_PACKET] = "ZODIAC",
+    [TSIP_PACKET] = "TSIP",
+    [EVERMORE_PACKET] = "EVERMORE",
+    [ITALK_PACKET] = "ITALK",
+    [GARMIN_PACKET] = "GARMIN",
+    [NAVCOM_PACKET] = "NAVCOM",
+    [UBX_PACKET] = "UBX",
+    [SUPERSTAR2_PACKET] = "SUPERSTAR2",
+    [ONCORE_PACKET] = "ONCORE",
+    [GEOSTAR_PACKET] = "GEOSTAR",
+    [NMEA2000_PACKET] = "NMEA2000",
+    [GREIS_PACKET] = "GREIS",
+    [RTCM2_PACKET] = "RTCM2",
+    [RTCM3_PACKET] = "RTCM3",
+    [JSON_PACKET] = "JSON",
+    [PACKET_TYPES] = NULL,
+    [SKY_PACKET] = "SKYTRAQ",
+};
+#define BENCH_TYPES	(sizeof(bench_names) / sizeof(bench_names[0]))
+
+struct bench_corpus {
+    unsigned char *buf;
+    size_t len, room;
+    size_t *ends;			/* where each packet ends in buf */
+    size_t npackets, nroom;
+};
+
+static void bench_append(struct bench_corpus *cp,
+			 const unsigned char *data, size_t len, bool packet)
+{
+    if (cp->len + len > cp->room) {
+	cp->room = (cp->len + len) * 2;
+	if ((cp->buf = realloc(cp->buf, cp->room)) == NULL) {
+	    (void)fputs("test_packet: out of memory\n", stderr);
+	    exit(EXIT_FAILURE);
+	}
+    }
+    memcpy(cp->buf + cp->len, data, len);
+    cp->len += len;
+    if (!packet)
+	return;
+    if (cp->npackets == cp->nroom) {
+	cp->nroom = cp->nroom * 2 + 64;
+	cp->ends = realloc(cp->ends, cp->nroom * sizeof(size_t));
+	if (cp->ends == NULL) {
+	    (void)fputs("test_packet: out of memory\n", stderr);
+	    exit(EXIT_FAILURE);
+	}
+    }
+    cp->ends[cp->npackets++] = cp->len;
+}
+
+static void bench_load(struct bench_corpus *cp, char **files, int nfiles)
+/* append recorded captures to a corpus, back to back */
+{
+    int i;
+
+    for (i = 0; i < nfiles; i++) {
+	unsigned char buf[BUFSIZ];
+	size_t n;
+	FILE *fp = fopen(files[i], "rb");
+
+	if (fp == NULL) {
+	    (void)fprintf(stderr, "test_packet: can't open %s\n", files[i]);
+	    exit(EXIT_FAILURE);
+	}
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+	    bench_append(cp, buf, n, false);
+	(void)fclose(fp);
+    }
+}
+
+static unsigned long bench_feed(struct gps_lexer_t *lexer,
+				const unsigned char *buf, size_t len,
+				struct bench_corpus *sort)
+/* lex a buffer, returning the packet count; optionally sort packets by type */
+{
+    struct gps_frame_t frames[64];
+    unsigned long packets = 0;
+    size_t off = 0;
+
+    while (off < len) {
+	size_t n = packet_space(lexer);
+	size_t i, got;
+
+	if (n > BENCH_CHUNK)
+	    n = BENCH_CHUNK;
+	if (n > len - off)
+	    n = len - off;
+	memcpy(lexer->inbuffer + lexer->inbuflen, buf + off, n);
+	lexer->inbuflen += n;
+	lexer->char_counter += n;
+	off += n;
+	while ((got = packet_frames(lexer, frames,
+				    sizeof(frames) / sizeof(frames[0]))) > 0) {
+	    packets += got;
+	    if (sort != NULL)
+		for (i = 0; i < got; i++)
+		    if (frames[i].type >= 0
+			&& (size_t)frames[i].type < BENCH_TYPES)
+			bench_append(&sort[frames[i].type],
+				     frames[i].data, frames[i].len, true);
+	}
+    }
+    return packets;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define bench_cycles()	__rdtsc()
+#else
+#define bench_cycles()	0ULL
+#endif
+
+static void bench_run(const char *label, const struct bench_corpus *cp,
+		      int passes)
+{
+    static struct gps_lexer_t lexer;
+    struct timespec start, end;
+    unsigned long long c0, c1;
+    unsigned long packets = 0;
+    double elapsed, bytes;
+    int i;
+
+    if (cp->len == 0)
+	return;
+    lexer_init(&lexer);
+    lexer.errout.label = "test_packet";
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    c0 = bench_cycles();
+    for (i = 0; i < passes; i++) {
+	packet_reset(&lexer);
+	packets += bench_feed(&lexer, cp->buf, cp->len, NULL);
+    }
+    c1 = bench_cycles();
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec)
+	+ (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    bytes = (double)cp->len * passes;
+    (void)printf("%-12s %10zu %8lu %9.2f %12.0f",
+		 label, cp->len, packets / passes,
+		 bytes / elapsed / 1e6, packets / elapsed);
+    if (c1 > c0)
+	(void)printf(" %7.2f\n", (double)(c1 - c0) / bytes);
+    else
+	(void)printf(" %7s\n", "-");
+}
+
+static void bench_nmea(const struct bench_corpus *nmea, int passes)
+/* time NMEA sentence decoding, dispatch included */
+{
+    static struct gps_context_t context;
+    static struct gps_device_t session;
+    struct timespec start, end;
+    unsigned long long c0, c1;
+    double elapsed;
+    int i;
+
+    if (nmea->npackets == 0)
+	return;
+    gps_context_init(&context, "test_packet");
+    context.errout.debug = verbose;
+    gpsd_init(&session, &context, "test_packet");
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    c0 = bench_cycles();
+    for (i = 0; i < passes; i++) {
+	size_t from = 0, n;
+
+	for (n = 0; n < nmea->npackets; n++) {
+	    char sentence[MAX_PACKET_LENGTH + 1];
+	    size_t len = nmea->ends[n] - from;
+
+	    if (len > MAX_PACKET_LENGTH)
+		len = MAX_PACKET_LENGTH;
+	    memcpy(sentence, nmea->buf + from, len);
+	    sentence[len] = '\0';
+	    (void)nmea_parse(sentence, &session);
+	    from = nmea->ends[n];
+	}
+    }
+    c1 = bench_cycles();
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec)
+	+ (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    (void)printf("\n%-12s %8s %12s %9s %9s\n",
+		 "decode", "packets", "packets/sec", "ns/pkt", "cyc/pkt");
+    (void)printf("%-12s %8zu %12.0f %9.1f",
+		 "NMEA", nmea->npackets,
+		 nmea->npackets * passes / elapsed,
+		 elapsed * 1e9 / (nmea->npackets * passes));
+    if (c1 > c0)
+	(void)printf(" %9.1f\n",
+		     (double)(c1 - c0) / (nmea->npackets * passes));
+    else
+	(void)printf(" %9s\n", "-");
+}
+
+static void benchmark(int passes, const char *protocol,
+		      char **files, int nfiles)
+/* time the lexer, all protocols or one, over recorded and synthetic input */
+{
+    static struct gps_lexer_t lexer;
+    struct bench_corpus all = {0}, synth = {0}, mixed = {0}, noise = {0};
+    struct bench_corpus bytype[BENCH_TYPES];
+    size_t next[BENCH_TYPES];
+    size_t want = BENCH_TYPES;
+    unsigned int seed = 1;
+    size_t t;
+    bool more;
+
+    memset(bytype, 0, sizeof(bytype));
+    memset(next, 0, sizeof(next));
+
+    if (protocol != NULL) {
+	for (want = 0; want < BENCH_TYPES; want++)
+	    if (bench_names[want] != NULL
+		&& strcmp(bench_names[want], protocol) == 0)
+		break;
+	if (want == BENCH_TYPES) {
+	    (void)fprintf(stderr, "test_packet: unknown protocol %s\n",
+			  protocol);
+	    exit(EXIT_FAILURE);
+	}
+    }
+
+    bench_load(&all, files, nfiles);
+    /* sort what the lexer finds by type */
+    lexer_init(&lexer);
+    lexer.errout.label = "test_packet";
+    (void)bench_feed(&lexer, all.buf, all.len, bytype);
+    if (want != BENCH_TYPES && bytype[want].npackets == 0) {
+	(void)fprintf(stderr, "test_packet: no %s packets in input\n",
+		      protocol);
+	exit(EXIT_FAILURE);
+    }
+
+    (void)printf("%-12s %10s %8s %9s %12s %7s\n",
+		 "input", "bytes", "packets", "MB/sec", "packets/sec",
+		 "cyc/B");
+    if (want != BENCH_TYPES) {
+	bench_run(bench_names[want], &bytype[want], passes);
+	if (want == NMEA_PACKET)
+	    bench_nmea(&bytype[want], passes);
+    } else {
+	/* synthetic: the identification corpus, good and bad alike */
+	while (synth.len < BENCH_SYNTH) {
+	    struct map *mp;
+
+	    for (mp = singletests; mp < singletests + NITEMS(singletests); mp++)
+		bench_append(&synth, (unsigned char *)mp->test, mp->testlen,
+			     false);
+	}
+	/* deal one packet of each type in turn */
+	do {
+	    more = false;
+	    for (t = 0; t < BENCH_TYPES; t++)
+		if (next[t] < bytype[t].npackets) {
+		    size_t from = 0;
+
+		    if (next[t] > 0)
+			from = bytype[t].ends[next[t] - 1];
+
+		    bench_append(&mixed, bytype[t].buf + from,
+				 bytype[t].ends[next[t]] - from, true);
+		    next[t]++;
+		    more = true;
+		}
+	} while (more);
+	/* line noise, for the cost of finding nothing */
+	while (noise.len < BENCH_SYNTH) {
+	    unsigned char c;
+
+	    seed = seed * 1103515245 + 12345;
+	    c = (unsigned char)(seed >> 16);
+	    bench_append(&noise, &c, 1, false);
+	}
+
+	bench_run("captures", &all, passes);
+	bench_run("interleaved", &mixed, passes);
+	bench_run("synthetic", &synth, passes);
+	bench_run("noise", &noise, passes);
+	for (t = 0; t < BENCH_TYPES; t++)
+	    if (bench_names[t] != NULL)
+		bench_run(bench_names[t], &bytype[t], passes);
+    }
+
+    free(all.buf);
+    free(synth.buf);
+    free(mixed.buf);
+    free(mixed.ends);
+    free(noise.buf);
+    for (t = 0; t < BENCH_TYPES; t++) {
+	free(bytype[t].buf);
+	free(bytype[t].ends);
+    }
+}
+
 static int property_check(void)
 {
     const struct gps_type_t **dp;
@@ -373,13 +898,20 @@ int main(int argc, char *argv[])
 {
     struct map *mp;
     int failcount = 0;
-    int option, singletest = 0;
+    int option, singletest = 0, passes = 0;
+    const char *protocol = NULL;
 
     verbose = 0;
-    while ((option = getopt(argc, argv, "ce:t:v:")) != -1) {
+    while ((option = getopt(argc, argv, "b:ce:P:t:v:")) != -1) {
 	switch (option) {
+	case 'b':
+	    passes = atoi(optarg);
+	    break;
 	case 'c':
 	    exit(property_check());
+	case 'P':
+	    protocol = optarg;
+	    break;
 	case 'e':
 	    mp = singletests + atoi(optarg) - 1;
 	    (void)fwrite(mp->test, mp->testlen, sizeof(char), stdout);
@@ -394,6 +926,10 @@ int main(int argc, char *argv[])
 	}
     }
 
+    if (passes > 0) {
+	benchmark(passes, protocol, argv + optind, argc - optind);
+	exit(EXIT_SUCCESS);
+    }
     if (singletest)
 	failcount += packet_test(singletests + singletest - 1);
     else {
@@ -404,6 +940,14 @@ int main(int argc, char *argv[])
 	    failcount += packet_test(mp);
 	(void)fputs("=== EOF with buffer nonempty test ===\n", stdout);
 	runon_test(&runontests[0]);
+	(void)fputs("=== Burst extraction test ===\n", stdout);
+	failcount += frames_test(&runontests[0]);
+	(void)fputs("=== Long frame test ===\n", stdout);
+	failcount += long_frame_test();
+	(void)fputs("=== Typemask test ===\n", stdout);
+	failcount += typemask_test();
+	(void)fputs("=== Checksum test ===\n", stdout);
+	failcount += checksum_test();
     }
     exit(failcount > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
 }
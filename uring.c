@@ -0,0 +1,241 @@
+/****************************************************************************
+
+NAME
+   uring.c - minimal io_uring(7) submission ring for the daemon
+
+DESCRIPTION
+   The daemon uses one ring, from the main thread only, to hand the
+kernel all the client writes of a reporting cycle, or all the reads of
+the devices that select/epoll found ready, in a single system call.
+liburing is not required; the ring is set up with the raw system calls.
+If the kernel does not support io_uring, uring_init() fails and the
+daemon keeps using plain read(2) and writev(2).
+
+PERMISSIONS
+   This file is Copyright (c) 2019 by the GPSD project
+   SPDX-License-Identifier: BSD-2-clause
+
+***************************************************************************/
+
+#include "gpsd_config.h"
+
+#ifdef IO_URING_ENABLE
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+#include "gpsd.h"
+#include "compiler.h"
+
+static struct {
+    int fd;
+    unsigned entries;
+    /* submission queue */
+    void *sq_map;
+    size_t sq_size;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned sq_local;		/* tail as far as uring_get_sqe() has gone */
+    unsigned sq_flushed;	/* tail as far as the kernel has been told */
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    /* completion queue */
+    void *cq_map;
+    size_t cq_size;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+} ring = {.fd = -1};
+
+static int uring_setup(unsigned entries, struct io_uring_params *p)
+{
+#ifdef __NR_io_uring_setup
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif /* __NR_io_uring_setup */
+}
+
+static int uring_enter(unsigned to_submit, unsigned min_complete,
+		       unsigned flags)
+{
+#ifdef __NR_io_uring_enter
+    return (int)syscall(__NR_io_uring_enter, ring.fd, to_submit,
+			min_complete, flags, NULL, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif /* __NR_io_uring_enter */
+}
+
+void uring_wrap(void)
+/* tear the ring down */
+{
+    if (ring.fd == -1)
+	return;
+    if (ring.sqes != NULL)
+	(void)munmap(ring.sqes, ring.sqes_size);
+    if (ring.cq_map != NULL && ring.cq_map != ring.sq_map)
+	(void)munmap(ring.cq_map, ring.cq_size);
+    if (ring.sq_map != NULL)
+	(void)munmap(ring.sq_map, ring.sq_size);
+    (void)close(ring.fd);
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = -1;
+}
+
+bool uring_init(unsigned entries, const struct gpsd_errout_t *errout)
+/* set up a ring of the given size; false if the kernel can't */
+{
+    struct io_uring_params p;
+
+    memset(&p, 0, sizeof(p));
+    if ((ring.fd = uring_setup(entries, &p)) == -1) {
+	gpsd_log(errout, LOG_INF,
+		 "io_uring unavailable (%s), using plain I/O\n",
+		 strerror(errno));
+	return false;
+    }
+#ifdef IORING_FEAT_NODROP
+    /* 5.5 kernels have everything we use, and don't lose completions */
+    if ((p.features & IORING_FEAT_NODROP) == 0)
+#endif /* IORING_FEAT_NODROP */
+    {
+	gpsd_log(errout, LOG_INF,
+		 "io_uring too old, using plain I/O\n");
+	(void)close(ring.fd);
+	ring.fd = -1;
+	return false;
+    }
+    ring.entries = p.sq_entries;
+
+    ring.sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring.cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if ((p.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+	if (ring.cq_size > ring.sq_size)
+	    ring.sq_size = ring.cq_size;
+	ring.cq_size = ring.sq_size;
+    }
+    ring.sq_map = mmap(NULL, ring.sq_size, PROT_READ | PROT_WRITE,
+		       MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+    if (ring.sq_map == MAP_FAILED) {
+	ring.sq_map = NULL;
+	goto fail;
+    }
+    if ((p.features & IORING_FEAT_SINGLE_MMAP) != 0)
+	ring.cq_map = ring.sq_map;
+    else {
+	ring.cq_map = mmap(NULL, ring.cq_size, PROT_READ | PROT_WRITE,
+			   MAP_SHARED | MAP_POPULATE, ring.fd,
+			   IORING_OFF_CQ_RING);
+	if (ring.cq_map == MAP_FAILED) {
+	    ring.cq_map = NULL;
+	    goto fail;
+	}
+    }
+    ring.sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring.sqes = mmap(NULL, ring.sqes_size, PROT_READ | PROT_WRITE,
+		     MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+    if (ring.sqes == MAP_FAILED) {
+	ring.sqes = NULL;
+	goto fail;
+    }
+
+    ring.sq_head = (unsigned *)((char *)ring.sq_map + p.sq_off.head);
+    ring.sq_tail = (unsigned *)((char *)ring.sq_map + p.sq_off.tail);
+    ring.sq_mask = (unsigned *)((char *)ring.sq_map + p.sq_off.ring_mask);
+    ring.sq_array = (unsigned *)((char *)ring.sq_map + p.sq_off.array);
+    ring.sq_local = ring.sq_flushed = *ring.sq_tail;
+    ring.cq_head = (unsigned *)((char *)ring.cq_map + p.cq_off.head);
+    ring.cq_tail = (unsigned *)((char *)ring.cq_map + p.cq_off.tail);
+    ring.cq_mask = (unsigned *)((char *)ring.cq_map + p.cq_off.ring_mask);
+    ring.cqes = (struct io_uring_cqe *)((char *)ring.cq_map + p.cq_off.cqes);
+
+    gpsd_log(errout, LOG_INF, "io_uring ready, %u entries\n", ring.entries);
+    return true;
+
+fail:
+    gpsd_log(errout, LOG_WARN,
+	     "io_uring mmap failed (%s), using plain I/O\n", strerror(errno));
+    uring_wrap();
+    return false;
+}
+
+bool uring_register_buffers(const struct iovec *iov, unsigned count)
+/* pin buffers for IORING_OP_READ_FIXED, indexed as in iov */
+{
+#ifdef __NR_io_uring_register
+    return syscall(__NR_io_uring_register, ring.fd,
+		   IORING_REGISTER_BUFFERS, iov, count) == 0;
+#else
+    errno = ENOSYS;
+    return false;
+#endif /* __NR_io_uring_register */
+}
+
+struct io_uring_sqe *uring_get_sqe(void)
+/* a cleared submission entry, or NULL if the ring is full */
+{
+    struct io_uring_sqe *sqe;
+    unsigned head = *(volatile unsigned *)ring.sq_head;
+
+    if (ring.sq_local - head >= ring.entries)
+	return NULL;
+    sqe = &ring.sqes[ring.sq_local & *ring.sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    ring.sq_array[ring.sq_local & *ring.sq_mask] = ring.sq_local & *ring.sq_mask;
+    ring.sq_local++;
+    return sqe;
+}
+
+int uring_submit(unsigned wait_nr)
+/*
+ * Hand the kernel everything prepared since the last call and wait
+ * for at least wait_nr completions.  Return the number of entries
+ * submitted, or -1 on error.
+ */
+{
+    unsigned total = ring.sq_local - ring.sq_flushed, count = total;
+    int status;
+
+    /* entries must be visible before the kernel sees the new tail */
+    memory_barrier();
+    *(volatile unsigned *)ring.sq_tail = ring.sq_local;
+    memory_barrier();
+    ring.sq_flushed = ring.sq_local;
+    for (;;) {
+	status = uring_enter(count, wait_nr,
+			     wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+	if (status != -1 || errno != EINTR)
+	    break;
+	/* the kernel may have taken some before the signal came in */
+	memory_barrier();
+	count = ring.sq_local - *(volatile unsigned *)ring.sq_head;
+    }
+    if (status == -1)
+	return -1;
+    return (int)(total - count) + status;
+}
+
+bool uring_reap(struct io_uring_cqe *cqe)
+/* pop one completion into cqe; false if there is none */
+{
+    unsigned head = *ring.cq_head;
+
+    if (head == *(volatile unsigned *)ring.cq_tail)
+	return false;
+    /* don't read the entry before seeing the tail that published it */
+    memory_barrier();
+    *cqe = ring.cqes[head & *ring.cq_mask];
+    memory_barrier();
+    *(volatile unsigned *)ring.cq_head = head + 1;
+    return true;
+}
+
+#endif /* IO_URING_ENABLE */
+
+/* end */